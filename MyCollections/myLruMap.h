@@ -0,0 +1,475 @@
+/********************************************************************************************
+ * File: myLruMap.h
+ * ----------------
+ * v.1 2026/10/18
+ *
+ * v.2 2026/10/18
+ * - pairs are found by MyMap index instead of own buckets
+ * - pair, which alone exceeds byte budget, is evicted too
+ *
+ * This file exports the template class of capacity-bounded
+ * map - least recently used (LRU) cache. It finds pairs by
+ * MyMap, and evicts the oldest pair as soon as configured
+ * limits are exceeded.
+ ********************************************************************************************/
+
+#ifndef _myLruMap_h
+#define _myLruMap_h
+
+#include <cstdlib>
+#include <functional>
+#include "error.h"
+#include "myMap.h"
+
+
+/*
+ * Class: MyLruMap<KeyType, ValueType>
+ * -----------------------------------
+ * Implements cache, where every pair is stored in entry
+ * of doubly linked recency list, and MyMap index finds
+ * the entry by key. Any get or put moves the pair to the head
+ * of this list, and pairs are evicted from its tail.
+ *
+ * Limits are the count of pairs (capacity) and, optionally,
+ * the sum of pairs costs in bytes (byte budget).
+ */
+template <typename KeyType, typename ValueType>
+class MyLruMap {
+
+    /* Forward reference */
+    struct Entry;
+
+/* -----------------------------------------------------------------------------------------//
+ * Interface section
+ * -----------------------------------------------------------------------------------------*/
+public:
+
+    /*
+     * Type: EvictionCallback
+     * ----------------------
+     * Function which is called for every evicted pair,
+     * right before it will be deleted.
+     */
+    typedef std::function<void (const KeyType&, ValueType&)> EvictionCallback;
+
+    /*
+     * Constructor: MyLruMap
+     * Usage: MyLruMap<KeyType, ValueType> cache(capacity);
+     *        MyLruMap<KeyType, ValueType> cache(capacity, byteBudget);
+     * --------------------------------------------------------------
+     * Initializes a new empty cache, which stores not more then
+     * capacity pairs. If byteBudget is positive, the sum of pairs
+     * costs is limited by it too, so bytes() never exceeds it.
+     */
+    MyLruMap(int capacity, long byteBudget = 0);
+
+    /*
+     * Destructor: ~MyLruMap
+     * ---------------------
+     * Frees any heap storage associated with this cache.
+     * Eviction callback isn't called for destroyed pairs.
+     */
+    virtual ~MyLruMap();
+
+    /*
+     * Method: get
+     * Usage: ValueType value = cache.get(key);
+     * ----------------------------------------
+     * Returns the value associated with key and marks this
+     * pair as the most recently used.
+     * If key is not found, get returns the error message.
+     */
+    ValueType get(const KeyType& key);
+
+    /*
+     * Method: tryGet
+     * Usage: if (cache.tryGet(key, value)) ...
+     * ----------------------------------------
+     * Copies the value associated with key into value param
+     * and returns true. If there is no such key - returns
+     * false and value isn't changed.
+     */
+    bool tryGet(const KeyType& key, ValueType& value);
+
+    /*
+     * Method: put
+     * Usage: cache.put(key, value);
+     *        cache.put(key, value, cost);
+     * -----------------------------------
+     * Associates key with value and marks this pair as the most
+     * recently used. Cost is the pair size for byte budget, by
+     * default it's size of key and value objects.
+     * After insertion least recently used pairs are evicted
+     * while limits are exceeded. If the cost of new pair alone
+     * exceeds byte budget, this pair is evicted as well, with
+     * eviction callback, and cache doesn't keep it.
+     */
+    void put(const KeyType& key, const ValueType& value);
+    void put(const KeyType& key, const ValueType& value, long cost);
+
+    /*
+     * Method: containsKey
+     * Usage: if (cache.containsKey(key)) ...
+     * --------------------------------------
+     * Returns true if there is an entry for key. It doesn't
+     * change recency order and hit/miss counters.
+     */
+    bool containsKey(const KeyType& key) const;
+
+    /*
+     * Method: remove
+     * Usage: cache.remove(key);
+     * -------------------------
+     * Removes the pair for key, if it exists. Eviction
+     * callback isn't called for removed pairs.
+     */
+    void remove(const KeyType& key);
+
+    /*
+     * Method: clear
+     * Usage: cache.clear();
+     * ---------------------
+     * Removes all pairs, counters stay unchanged.
+     */
+    void clear();
+
+    /*
+     * Method: setEvictionCallback
+     * Usage: cache.setEvictionCallback(fn);
+     * -------------------------------------
+     * Sets function fn(key, value) to call for every
+     * evicted pair.
+     */
+    void setEvictionCallback(EvictionCallback fn);
+
+    /*
+     * Methods: size, isEmpty, capacity, byteBudget, bytes
+     * ---------------------------------------------------
+     * Return current count of pairs, limits of this cache
+     * and current sum of pairs costs.
+     */
+    int size() const;
+    bool isEmpty() const;
+    int capacity() const;
+    long byteBudget() const;
+    long bytes() const;
+
+    /*
+     * Methods: hits, misses, evictions, resetCounters
+     * -----------------------------------------------
+     * Counters of successful and failed get/tryGet calls,
+     * and count of evicted pairs.
+     */
+    long hits() const;
+    long misses() const;
+    long evictions() const;
+    void resetCounters();
+
+/* -----------------------------------------------------------------------------------------//
+ * Private section
+ * -----------------------------------------------------------------------------------------*/
+private:
+    /*
+     * Implementation notes: MyLruMap internal structure
+     * -------------------------------------------------
+     * Each entry has prev and next pointers of the recency
+     * list: head is the most recently used entry, tail - the
+     * candidate to eviction. MyMap index keeps pointer on the
+     * entry of every key, so both lookup and reordering take
+     * constant time, and all hashing and rehashing is MyMap's.
+     *
+     * Index is reserved for capacity at construction, but
+     * not for more then MAX_INITIAL_RESERVE pairs - bigger
+     * index is grown by MyMap itself.
+     */
+
+    /* Copying isn't supported */
+    MyLruMap(const MyLruMap& src);
+    MyLruMap& operator =(const MyLruMap& src);
+
+    /* Type: Entry
+     * -----------
+     * Main storage object for user values.
+     */
+    struct Entry {
+        KeyType key;
+        ValueType data;
+        long cost;
+        Entry* prev;        /* More recently used entry    */
+        Entry* next;        /* Less recently used entry    */
+    };
+
+    static const int MAX_INITIAL_RESERVE = 4096; //Biggest count of pairs reserved in index.
+    MyMap<KeyType, Entry*> index;   //Entry of every key.
+    int maxElements;                //Capacity limit.
+    long maxBytes;                  //Byte budget, 0 if unused.
+    long currentBytes;              //Sum of entries costs.
+    Entry* head;                    //Most recently used entry.
+    Entry* tail;                    //Least recently used entry.
+    EvictionCallback onEviction;
+    long hitsCount;
+    long missesCount;
+    long evictionsCount;
+
+    /*
+     * Private methods: internal helpers
+     * ---------------------------------
+     * findEntry    - entry for key or NULL
+     * unlink       - removes entry from recency list
+     * pushFront    - inserts entry at the head of recency list
+     * removeEntry  - removes entry from index and list, deletes it
+     * evictOverflow - evicts tail entries while limits are exceeded
+     */
+    Entry* findEntry(const KeyType& key) const;
+    void unlink(Entry* entry);
+    void pushFront(Entry* entry);
+    void removeEntry(Entry* entry);
+    void evictOverflow();
+};
+
+
+/* -----------------------------------------------------------------------------------------//
+ * Implementation section
+ * -----------------------------------------------------------------------------------------*/
+
+/*
+ * Implementation notes: MyLruMap constructor
+ * ------------------------------------------
+ * Index is reserved for capacity, so small cache
+ * is never rehashed.
+ */
+template <typename KeyType, typename ValueType>
+MyLruMap<KeyType, ValueType>::MyLruMap(int capacity, long byteBudget) {
+    if (capacity <= 0) {
+        error("MyLruMap: capacity has to be positive");
+    }
+    maxElements = capacity;
+    maxBytes = (byteBudget > 0) ? byteBudget : 0;
+    index.reserve((capacity < MAX_INITIAL_RESERVE) ? capacity : MAX_INITIAL_RESERVE);
+    currentBytes = 0;
+    head = NULL;
+    tail = NULL;
+    hitsCount = 0;
+    missesCount = 0;
+    evictionsCount = 0;
+}
+
+template <typename KeyType, typename ValueType>
+MyLruMap<KeyType, ValueType>::~MyLruMap() {
+    clear();
+}
+
+/*
+ * Implementation notes: get, tryGet
+ * ---------------------------------
+ * Found entry is moved to the head of recency list.
+ */
+template <typename KeyType, typename ValueType>
+ValueType MyLruMap<KeyType, ValueType>::get(const KeyType& key) {
+    ValueType result = ValueType();
+    if (!tryGet(key, result)) {
+        error("get: No pair for this key");
+    }
+    return result;
+}
+
+template <typename KeyType, typename ValueType>
+bool MyLruMap<KeyType, ValueType>::tryGet(const KeyType& key, ValueType& value) {
+    Entry* entry = findEntry(key);
+    if (entry == NULL) {
+        missesCount++;
+        return false;
+    }
+    hitsCount++;
+    if (entry != head) {
+        unlink(entry);
+        pushFront(entry);
+    }
+    value = entry->data;
+    return true;
+}
+
+/*
+ * Implementation notes: put
+ * -------------------------
+ * If such key exist - updates value and cost of its entry.
+ * If not - creates new entry in index and at the head
+ * of recency list. Then evicts tail while it's needed.
+ */
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
+    put(key, value, (long)(sizeof(KeyType) + sizeof(ValueType)));
+}
+
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value, long cost) {
+    Entry* entry = findEntry(key);
+    if (entry == NULL) {
+        entry = new Entry;
+        entry->key = key;
+        entry->cost = 0;
+        index.put(key, entry);
+    } else {
+        unlink(entry);
+    }
+    entry->data = value;
+    currentBytes += cost - entry->cost;
+    entry->cost = cost;
+    pushFront(entry);
+    evictOverflow();
+}
+
+template <typename KeyType, typename ValueType>
+bool MyLruMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
+    return findEntry(key) != NULL;
+}
+
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::remove(const KeyType& key) {
+    Entry* entry = findEntry(key);
+    if (entry != NULL) {
+        removeEntry(entry);
+    }
+}
+
+/*
+ * Implementation notes: clear
+ * ---------------------------
+ * All entries are in recency list, so it's enough
+ * to traverse this list to delete them.
+ */
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::clear() {
+    Entry* entry = head;
+    while (entry != NULL) {
+        Entry* oldEntry = entry;
+        entry = entry->next;
+        delete oldEntry;
+    }
+    index.clear();
+    head = NULL;
+    tail = NULL;
+    currentBytes = 0;
+}
+
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::setEvictionCallback(EvictionCallback fn) {
+    onEviction = fn;
+}
+
+template <typename KeyType, typename ValueType>
+int MyLruMap<KeyType, ValueType>::size() const {
+    return index.size();
+}
+
+template <typename KeyType, typename ValueType>
+bool MyLruMap<KeyType, ValueType>::isEmpty() const {
+    return index.isEmpty();
+}
+
+template <typename KeyType, typename ValueType>
+int MyLruMap<KeyType, ValueType>::capacity() const {
+    return maxElements;
+}
+
+template <typename KeyType, typename ValueType>
+long MyLruMap<KeyType, ValueType>::byteBudget() const {
+    return maxBytes;
+}
+
+template <typename KeyType, typename ValueType>
+long MyLruMap<KeyType, ValueType>::bytes() const {
+    return currentBytes;
+}
+
+template <typename KeyType, typename ValueType>
+long MyLruMap<KeyType, ValueType>::hits() const {
+    return hitsCount;
+}
+
+template <typename KeyType, typename ValueType>
+long MyLruMap<KeyType, ValueType>::misses() const {
+    return missesCount;
+}
+
+template <typename KeyType, typename ValueType>
+long MyLruMap<KeyType, ValueType>::evictions() const {
+    return evictionsCount;
+}
+
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::resetCounters() {
+    hitsCount = 0;
+    missesCount = 0;
+    evictionsCount = 0;
+}
+
+template <typename KeyType, typename ValueType>
+typename MyLruMap<KeyType, ValueType>::Entry*
+MyLruMap<KeyType, ValueType>::findEntry(const KeyType& key) const {
+    Entry* entry = NULL;
+    index.tryGet(key, entry);
+    return entry;
+}
+
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::unlink(Entry* entry) {
+    if (entry->prev != NULL) {
+        entry->prev->next = entry->next;
+    } else {
+        head = entry->next;
+    }
+    if (entry->next != NULL) {
+        entry->next->prev = entry->prev;
+    } else {
+        tail = entry->prev;
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::pushFront(Entry* entry) {
+    entry->prev = NULL;
+    entry->next = head;
+    if (head != NULL) {
+        head->prev = entry;
+    } else {
+        tail = entry;
+    }
+    head = entry;
+}
+
+/*
+ * Private function: removeEntry
+ * -----------------------------
+ * Unbinds entry from index and from recency list.
+ */
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::removeEntry(Entry* entry) {
+    index.remove(entry->key);
+    unlink(entry);
+    currentBytes -= entry->cost;
+    delete entry;
+}
+
+/*
+ * Private function: evictOverflow
+ * -------------------------------
+ * Evicts tail entries while count or bytes limits are
+ * exceeded. Capacity is at least one pair, so the head
+ * entry, just put, is reached only if its own cost is
+ * bigger then byte budget.
+ */
+template <typename KeyType, typename ValueType>
+void MyLruMap<KeyType, ValueType>::evictOverflow() {
+    while ((tail != NULL)
+           && ((index.size() > maxElements) || ((maxBytes > 0) && (currentBytes > maxBytes)))) {
+        Entry* victim = tail;
+        if (onEviction) {
+            onEviction(victim->key, victim->data);
+        }
+        evictionsCount++;
+        removeEntry(victim);
+    }
+}
+
+#endif
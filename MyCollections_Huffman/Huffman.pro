@@ -102,7 +102,9 @@ unix:!macx {
 !win32 {
     QMAKE_CXXFLAGS += -Wno-dangling-field
     QMAKE_CXXFLAGS += -Wno-unused-const-variable
+    QMAKE_CXXFLAGS += -pthread
     LIBS += -ldl
+    LIBS += -pthread
 }
 
 # increase system stack size (helpful for recursive programs)
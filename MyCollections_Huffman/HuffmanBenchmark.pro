@@ -0,0 +1,12 @@
+# Benchmark build of the Huffman project
+#
+# The same program as Huffman.pro builds, but global new and
+# delete are replaced by counting ones (see HuffmanBenchmark.cpp),
+# so "benchmark" command reports heap allocations. Normal build
+# keeps allocator of the library.
+#
+# @version 2026/10/18
+
+include(Huffman.pro)
+
+DEFINES += HUFFMAN_COUNT_ALLOCATIONS
@@ -5,20 +5,276 @@
  * - compress() is changed
  * - decompress() is changed
  *
+ * v.3 2026/10/18
+ * - command line mode, "range" command
+ *
+ * v.4 2026/10/18
+ * - "-" file name means standard input or output
+ *
+ * v.5 2026/10/18
+ * - "adaptive-compress", "adaptive-decompress" commands
+ *
+ * v.6 2026/10/18
+ * - "--rans" option of "compress"
+ *
+ * v.7 2026/10/18
+ * - "--lz77" option of "compress"
+ *
+ * v.8 2026/10/18
+ * - "--context" option of "compress"
+ *
+ * v.9 2026/10/18
+ * - "benchmark" command
+ *
+ * v.10 2026/10/18
+ * - "batch-compress", "batch-decompress" commands
+ *
+ * v.11 2026/10/18
+ * - demo without arguments is started by Stanford library again
+ *
+ * v.12 2026/10/18
+ * - "test" command
+ *
+ * v.13 2026/10/18
+ * - failed writing of stream commands is reported
+ *
+ * v.14 2026/10/18
+ * - "test" command runs collections tests too
+ *
  * Program makes Huffman principle compression and
  * decompression for user .txt file.
+ *
+ * Without arguments it makes demo compression and
+ * decompression of tomSawyer.txt. Command line mode:
+ *   Huffman compress [--rans | --lz77 | --context] <inputFile> <cypherFile>
+ *   Huffman decompress <cypherFile> <outFile>
+ *   Huffman range <cypherFile> <offset> <length>
+ * "range" writes length bytes of the original text from
+ * offset to standard output. File name "-" means standard
+ * input or output, so program could work in pipes:
+ *   cat log | Huffman compress - - | Huffman decompress - -
+ * "--rans" codes blocks by rANS coder instead of Huffman
+ * codes, "--lz77" replaces repeated strings by matches
+ * before Huffman coding, "--context" codes every byte by
+ * table of its previous byte. Decompress finds it out by itself.
+ * Adaptive commands code in one pass, and every coded byte
+ * leaves as soon as input pauses:
+ *   Huffman adaptive-compress <inputFile> <cypherFile>
+ *   Huffman adaptive-decompress <cypherFile> <outFile>
+ * Benchmark measures speed of every coding phase over res
+ * files or given files, and over generated texts of size
+ * megabytes, and writes JSON report to standard output:
+ *   Huffman benchmark [--size MB] [--repeat N] [--rans | --lz77 | --context] [files]
+ * Batch commands code every file of directory, or of list
+ * file with one path on every line, into outDir by all
+ * cores, and write line of every file as soon as it's done:
+ *   Huffman batch-compress [--rans | --lz77 | --context] <dir | listFile> <outDir>
+ *   Huffman batch-decompress <dir | listFile> <outDir>
+ * "test" runs self tests of src/test folder:
+ *   Huffman test
  **********************************************************/
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 #include "simpio.h"
 #include "console.h"
 #include "bstream.h"
 #include "HuffmanEncoding.h"
 #include "HuffmanDecoding.h"
 #include "HuffmanTypes.h"
+#include "HuffmanAdaptive.h"
+#include "HuffmanBenchmark.h"
+#include "HuffmanBatch.h"
+#include "HuffmanTests.h"
+#include "CollectionsTests.h"
+#include "error.h"
 
 using namespace std;
 
-int main() {
+/* Plain main() takes command line arguments. When there
+ * are no ones, it starts Stanford library the same way as
+ * library main macro does, so demo Main() gets console. */
+#undef main
+
+int Main();
+extern int _mainFlags;
+
+/* Function: printUsage
+ * --------------------
+ * Prints command line commands.
+ */
+static void printUsage() {
+    cerr << "Usage:" << endl;
+    cerr << "  Huffman compress [--rans | --lz77 | --context] <inputFile> <cypherFile>" << endl;
+    cerr << "  Huffman decompress <cypherFile> <outFile>" << endl;
+    cerr << "  Huffman range <cypherFile> <offset> <length>" << endl;
+    cerr << "  Huffman adaptive-compress <inputFile> <cypherFile>" << endl;
+    cerr << "  Huffman adaptive-decompress <cypherFile> <outFile>" << endl;
+    cerr << "  Huffman benchmark [--size MB] [--repeat N] [--rans | --lz77 | --context] [files]"
+         << endl;
+    cerr << "  Huffman batch-compress [--rans | --lz77 | --context] <dir | listFile> <outDir>"
+         << endl;
+    cerr << "  Huffman batch-decompress <dir | listFile> <outDir>" << endl;
+    cerr << "  Huffman test" << endl;
+    cerr << "File name \"-\" means standard input or output." << endl;
+}
+
+/* Function: runStreamCommand
+ * --------------------------
+ * Compresses or decompresses by streams, when at least one
+ * of files is standard stream, or coding is adaptive. Standard streams are switched
+ * to binary mode and aren't synced with stdio. Reports error
+ * if output can't be written.
+ */
+static void runStreamCommand(const string& command, const string& inName, const string& outName,
+                             BlockCoding coding) {
+    ios::sync_with_stdio(false);
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    istream* in = &cin;
+    ostream* out = &cout;
+    ifstream inFile;
+    ofstream outFile;
+    if (inName != "-") {
+        inFile.open(inName.c_str(), ios::binary);
+        if (!inFile.is_open()) error("Can't read file \"" + inName + "\"");
+        in = &inFile;
+    }
+    if (outName != "-") {
+        outFile.open(outName.c_str(), ios::binary);
+        if (!outFile.is_open()) error("Can't write file \"" + outName + "\"");
+        out = &outFile;
+    }
+
+    if (command == "compress") {
+        compressStream(*in, *out, MAX_CODE_LENGTH, 0, coding);
+    } else if (command == "decompress") {
+        decompressStream(*in, *out);
+    } else if (command == "adaptive-compress") {
+        compressAdaptiveStream(*in, *out);
+    } else {
+        decompressAdaptiveStream(*in, *out);
+    }
+    out->flush();
+    if (out->fail()) {
+        error((outName == "-") ? string("Can't write standard output")
+                               : "Can't write file \"" + outName + "\"");
+    }
+}
+
+/* Function: parseNumber
+ * ---------------------
+ * Converts not negative decimal argument, or reports error.
+ */
+static long long parseNumber(const string& text) {
+    char* end = NULL;
+    long long result = strtoll(text.c_str(), &end, 10);
+    if (text.empty() || (*end != '\0') || (result < 0)) {
+        error("Wrong number: " + text);
+    }
+    return result;
+}
+
+/* Function: runBenchmarkCommand
+ * -----------------------------
+ * Reads benchmark options and runs benchmark. Every
+ * argument, which isn't option, is file to measure.
+ */
+static void runBenchmarkCommand(int argCount, char** args) {
+    BenchmarkOptions options;
+    for (int i = 0; i < argCount; i++) {
+        string arg = args[i];
+        if ((arg == "--size") && (i + 1 < argCount)) {
+            options.generatedSize = parseNumber(args[++i]);
+        } else if ((arg == "--repeat") && (i + 1 < argCount)) {
+            options.repeat = (int) parseNumber(args[++i]);
+        } else if (arg == "--rans") {
+            options.coding = RANS_BLOCKS;
+        } else if (arg == "--lz77") {
+            options.coding = LZ77_BLOCKS;
+        } else if (arg == "--context") {
+            options.coding = CONTEXT_BLOCKS;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    runBenchmark(options, cout);
+}
+
+/* Function: runCommand
+ * --------------------
+ * Runs command line command. Returns exit code.
+ */
+static int runCommand(const string& command, int argCount, char** args) {
+    BlockCoding coding = INTERLEAVED_BLOCKS;
+    if (((command == "compress") || (command == "batch-compress")) && (argCount > 0)) {
+        string option = args[0];
+        bool isOption = true;
+        if (option == "--rans") {
+            coding = RANS_BLOCKS;
+        } else if (option == "--lz77") {
+            coding = LZ77_BLOCKS;
+        } else if (option == "--context") {
+            coding = CONTEXT_BLOCKS;
+        } else {
+            isOption = false;
+        }
+        if (isOption) {
+            args++;
+            argCount--;
+        }
+    }
+    bool isCoding = (command == "compress") || (command == "decompress");
+    bool isAdaptive = (command == "adaptive-compress") || (command == "adaptive-decompress");
+    if (isCoding && (argCount == 2) && ((string(args[0]) == "-") || (string(args[1]) == "-"))) {
+        runStreamCommand(command, args[0], args[1], coding);
+    } else if (isAdaptive && (argCount == 2)) {
+        runStreamCommand(command, args[0], args[1], coding);
+    } else if ((command == "compress") && (argCount == 2)) {
+        compress(args[0], args[1], MAX_CODE_LENGTH, 0, coding);
+    } else if ((command == "decompress") && (argCount == 2)) {
+        decompress(args[0], args[1]);
+    } else if (command == "benchmark") {
+        runBenchmarkCommand(argCount, args);
+    } else if (((command == "batch-compress") || (command == "batch-decompress"))
+               && (argCount == 2)) {
+        vector<BatchFile> files = listBatchFiles(args[0]);
+        int failed = runBatch(files, args[1], command == "batch-compress", 0, coding, cout);
+        return (failed > 0) ? 1 : 0;
+    } else if ((command == "test") && (argCount == 0)) {
+        int failed = runHuffmanTests(cout) + runCollectionsTests(cout);
+        return (failed > 0) ? 1 : 0;
+    } else if ((command == "range") && (argCount == 3)) {
+        string text = decompressRange(args[0], parseNumber(args[1]), parseNumber(args[2]));
+        cout.write(text.data(), text.size());
+        cout.flush();
+    } else {
+        printUsage();
+        return 2;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        _mainFlags = GRAPHICS_FLAG + CONSOLE_FLAG;
+        return startupMain(argc, argv);
+    }
+    try {
+        return runCommand(argv[1], argc - 2, argv + 2);
+    } catch (ErrorException& e) {
+        cerr << e.getMessage() << endl;
+        return 1;
+    }
+}
+
+int Main() {
    /* Huffman text file compression-decompression process
     * --------------------------------------------------------
     * Input file is coded due to Huffman compression rules
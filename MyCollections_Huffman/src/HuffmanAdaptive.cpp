@@ -0,0 +1,322 @@
+/**********************************************************
+* File: HuffmanAdaptive.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* Implementation of the functions from HuffmanAdaptive.h.
+*
+**********************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "error.h"
+#include "HuffmanAdaptive.h"
+
+using namespace std;
+
+/* Constant: ROOT
+ * Index of tree root.
+ */
+static const int ROOT = 0;
+
+/* Constant: ADAPTIVE_BUFFER_SIZE
+ * Size of input and output buffers of stream coding.
+ */
+static const int ADAPTIVE_BUFFER_SIZE = 1 << 16;
+
+AdaptiveTree::AdaptiveTree() {
+    for (int symbol = 0; symbol < ADAPTIVE_SYMBOLS; symbol++) {
+        leaves[symbol] = -1;
+    }
+    nodes[ROOT].weight = 2;
+    nodes[ROOT].parent = -1;
+    nodes[ROOT].child = 1;
+    nodes[ROOT].isLeaf = false;
+
+    nodes[1].weight = 1;
+    nodes[1].parent = ROOT;
+    nodes[1].child = PSEUDO_EOF;
+    nodes[1].isLeaf = true;
+    leaves[PSEUDO_EOF] = 1;
+
+    nodes[2].weight = 1;
+    nodes[2].parent = ROOT;
+    nodes[2].child = ADAPTIVE_ESCAPE;
+    nodes[2].isLeaf = true;
+    leaves[ADAPTIVE_ESCAPE] = 2;
+
+    nextFree = 3;
+    decodeNode = ROOT;
+    rawBitsLeft = 0;
+    rawSymbol = 0;
+}
+
+/* Method: writeCode
+ * -----------------
+ * Collects bits from symbol leaf up to the root. First
+ * children have odd indexes, so node parity is its bit.
+ * The last collected bit is the first bit of code.
+ */
+void AdaptiveTree::writeCode(int symbol, BitWriter& writer) {
+    unsigned long long code = 0;
+    int length = 0;
+    for (int node = leaves[symbol]; node != ROOT; node = nodes[node].parent) {
+        code = (code << 1) | ((node & 1) == 0 ? 1 : 0);
+        length++;
+    }
+    writer.writeBits(code, length);
+}
+
+void AdaptiveTree::encode(int symbol, BitWriter& writer) {
+    if (leaves[symbol] == -1) {
+        /* New byte */
+        writeCode(ADAPTIVE_ESCAPE, writer);
+        writer.writeByte(symbol);
+        addSymbol(symbol);
+    } else {
+        writeCode(symbol, writer);
+    }
+    if (symbol != PSEUDO_EOF) {
+        update(symbol);
+    }
+}
+
+/* Method: decodeBit
+ * -----------------
+ * Walks one step down the tree. After escape leaf next
+ * 8 bits are the new byte itself.
+ */
+ext_char AdaptiveTree::decodeBit(int bit) {
+    if (rawBitsLeft > 0) {
+        rawSymbol |= bit << (8 - rawBitsLeft);
+        if (--rawBitsLeft > 0) return NOT_A_CHAR;
+        addSymbol(rawSymbol);
+        update(rawSymbol);
+        return rawSymbol;
+    }
+
+    decodeNode = nodes[decodeNode].child + bit;
+    if (!nodes[decodeNode].isLeaf) return NOT_A_CHAR;
+    int symbol = nodes[decodeNode].child;
+    decodeNode = ROOT;
+    if (symbol == ADAPTIVE_ESCAPE) {
+        rawBitsLeft = 8;
+        rawSymbol = 0;
+        return NOT_A_CHAR;
+    }
+    if (symbol != PSEUDO_EOF) {
+        update(symbol);
+    }
+    return symbol;
+}
+
+/* Method: addSymbol
+ * -----------------
+ * The last node has the smallest weight and is a leaf.
+ * It becomes parent of its own leaf and of zero weight
+ * leaf of new symbol.
+ */
+void AdaptiveTree::addSymbol(int symbol) {
+    int lightest = nextFree - 1;
+    int oldLeaf = nextFree;
+    int newLeaf = nextFree + 1;
+    nextFree += 2;
+
+    nodes[oldLeaf] = nodes[lightest];
+    nodes[oldLeaf].parent = lightest;
+    leaves[nodes[oldLeaf].child] = oldLeaf;
+
+    nodes[lightest].child = oldLeaf;
+    nodes[lightest].isLeaf = false;
+
+    nodes[newLeaf].weight = 0;
+    nodes[newLeaf].parent = lightest;
+    nodes[newLeaf].child = symbol;
+    nodes[newLeaf].isLeaf = true;
+    leaves[symbol] = newLeaf;
+}
+
+/* Method: update
+ * --------------
+ * Increments weights from symbol leaf up to the root. Before
+ * every increment node is moved to the first place among
+ * nodes of its weight, so order of weights isn't broken.
+ */
+void AdaptiveTree::update(int symbol) {
+    if (nodes[ROOT].weight >= ADAPTIVE_MAX_WEIGHT) {
+        rebuild();
+    }
+    int node = leaves[symbol];
+    while (node != -1) {
+        nodes[node].weight++;
+        int leader = node;
+        while ((leader > ROOT) && (nodes[leader - 1].weight < nodes[node].weight)) {
+            leader--;
+        }
+        if (leader != node) {
+            swapNodes(node, leader);
+            node = leader;
+        }
+        node = nodes[node].parent;
+    }
+}
+
+/* Method: swapNodes
+ * -----------------
+ * Swaps places of two subtrees. Nodes keep parents of their
+ * places, and children of nodes get new parent indexes.
+ */
+void AdaptiveTree::swapNodes(int i, int j) {
+    if (nodes[i].isLeaf) {
+        leaves[nodes[i].child] = j;
+    } else {
+        nodes[nodes[i].child].parent = j;
+        nodes[nodes[i].child + 1].parent = j;
+    }
+    if (nodes[j].isLeaf) {
+        leaves[nodes[j].child] = i;
+    } else {
+        nodes[nodes[j].child].parent = i;
+        nodes[nodes[j].child + 1].parent = i;
+    }
+    TreeNode temp = nodes[i];
+    nodes[i] = nodes[j];
+    nodes[i].parent = temp.parent;
+    temp.parent = nodes[j].parent;
+    nodes[j] = temp;
+}
+
+/* Method: rebuild
+ * ---------------
+ * Halves weights of leaves and builds new Huffman tree:
+ * - leaves are moved to the end of array, keeping order;
+ * - from the end, every two nodes get a parent, which is
+ *   inserted into its weight place before them;
+ * - parents and leaves links are restored.
+ */
+void AdaptiveTree::rebuild() {
+    int j = nextFree - 1;
+    for (int i = j; i >= ROOT; i--) {
+        if (nodes[i].isLeaf) {
+            nodes[j] = nodes[i];
+            nodes[j].weight = (nodes[j].weight + 1) / 2;
+            j--;
+        }
+    }
+
+    for (int i = nextFree - 2; j >= ROOT; i -= 2, j--) {
+        int weight = nodes[i].weight + nodes[i + 1].weight;
+        int k = j + 1;
+        while (weight < nodes[k].weight) {
+            k++;
+        }
+        k--;
+        memmove(&nodes[j], &nodes[j + 1], (k - j) * sizeof(TreeNode));
+        nodes[k].weight = weight;
+        nodes[k].child = i;
+        nodes[k].isLeaf = false;
+    }
+
+    for (int i = nextFree - 1; i >= ROOT; i--) {
+        if (nodes[i].isLeaf) {
+            leaves[nodes[i].child] = i;
+        } else {
+            nodes[nodes[i].child].parent = i;
+            nodes[nodes[i].child + 1].parent = i;
+        }
+    }
+    nodes[ROOT].parent = -1;
+}
+
+/* Function: readReady
+ * -------------------
+ * Reads bytes, which stream has ready. If it has none,
+ * calls beforeWait and waits for at least one byte.
+ * Returns 0 at the end of stream.
+ */
+template <typename Callback>
+static size_t readReady(istream& in, char* buffer, size_t size, Callback beforeWait) {
+    streamsize count = in.readsome(buffer, size);
+    if (count > 0) return count;
+    beforeWait();
+    in.read(buffer, 1);
+    return in.gcount();
+}
+
+void compressAdaptiveStream(istream& in, ostream& out) {
+    BitWriter writer(out);
+    for (int i = 0; i < HEADER_MAGIC_SIZE; i++) {
+        writer.writeByte(HEADER_MAGIC[i]);
+    }
+    writer.writeByte(ADAPTIVE_VERSION);
+
+    AdaptiveTree tree;
+    vector<char> inBuffer(ADAPTIVE_BUFFER_SIZE);
+    while (true) {
+        size_t count = readReady(in, &inBuffer[0], inBuffer.size(),
+                                 [&writer] { writer.flushBytes(); });
+        if (count == 0) break;
+        for (size_t i = 0; i < count; i++) {
+            tree.encode((unsigned char) inBuffer[i], writer);
+        }
+    }
+    tree.encode(PSEUDO_EOF, writer);
+    writer.flush();
+}
+
+void decompressAdaptiveStream(istream& in, ostream& out) {
+    char header[HEADER_MAGIC_SIZE + 1];
+    in.read(header, sizeof(header));
+    if (!isAdaptiveStream(header, in.gcount())) {
+        error("decompressAdaptiveStream: Stream is not adaptive Huffman stream");
+    }
+
+    AdaptiveTree tree;
+    vector<char> inBuffer(ADAPTIVE_BUFFER_SIZE);
+    vector<char> outBuffer(ADAPTIVE_BUFFER_SIZE);
+    size_t outPos = 0;
+    auto flushText = [&] {
+        out.write(&outBuffer[0], outPos);
+        out.flush();
+        outPos = 0;
+    };
+
+    while (true) {
+        size_t count = readReady(in, &inBuffer[0], inBuffer.size(), flushText);
+        if (count == 0) {
+            error("decompressAdaptiveStream: Stream is over without EOF code");
+        }
+        for (size_t i = 0; i < count; i++) {
+            int byte = (unsigned char) inBuffer[i];
+            /* Bits go from the lowest one */
+            for (int bit = 0; bit < 8; bit++) {
+                ext_char symbol = tree.decodeBit((byte >> bit) & 1);
+                if (symbol == NOT_A_CHAR) continue;
+                if (symbol == PSEUDO_EOF) {
+                    flushText();
+                    return;
+                }
+                outBuffer[outPos++] = (char) symbol;
+                if (outPos == outBuffer.size()) {
+                    flushText();
+                }
+            }
+        }
+    }
+}
+
+bool isAdaptiveStream(const char* data, size_t size) {
+    if (size < (size_t) HEADER_MAGIC_SIZE + 1) return false;
+    if (memcmp(data, HEADER_MAGIC, HEADER_MAGIC_SIZE) != 0) return false;
+    return data[HEADER_MAGIC_SIZE] == ADAPTIVE_VERSION;
+}
+
+void compressAdaptive(string inputFile, string cypherFile) {
+    ifstream in(inputFile.c_str(), ios::binary);
+    if (!in.is_open()) {
+        error("compressAdaptive: Can't read file \"" + inputFile + "\"");
+    }
+    ofstream out(cypherFile.c_str(), ios::binary);
+    compressAdaptiveStream(in, out);
+}
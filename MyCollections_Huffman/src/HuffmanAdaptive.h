@@ -0,0 +1,141 @@
+/*******************************************************
+* File: HuffmanAdaptive.h
+* --------------------------
+* v.1 2026/10/18
+*
+* Adaptive single pass Huffman coding (FGK algorithm).
+* Coder and decoder change the same tree after every
+* symbol, so no frequency pass and no code table are
+* needed, and codes go out as soon as bytes come in.
+*
+* Stream format: HEADER_MAGIC bytes, ADAPTIVE_VERSION byte,
+* then bit stream. New symbol is coded by ESCAPE code and
+* 8 bits of the byte. Stream is ended by PSEUDO_EOF code.
+*******************************************************/
+
+#ifndef HuffmanAdaptive_Included
+#define HuffmanAdaptive_Included
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include "HuffmanTypes.h"
+#include "bitio.h"
+
+/* Constant: ADAPTIVE_VERSION
+ * Format version byte of adaptive stream.
+ */
+const int ADAPTIVE_VERSION = 4;
+
+/* Constants: ADAPTIVE_ESCAPE, ADAPTIVE_SYMBOLS, ADAPTIVE_NODES
+ * Escape symbol, which goes before new bytes, count of all
+ * symbols, and count of nodes of the full tree.
+ */
+const int ADAPTIVE_ESCAPE = PSEUDO_EOF + 1;
+const int ADAPTIVE_SYMBOLS = ADAPTIVE_ESCAPE + 1;
+const int ADAPTIVE_NODES = 2 * ADAPTIVE_SYMBOLS - 1;
+
+/* Constant: ADAPTIVE_MAX_WEIGHT
+ * Root weight, after which all weights are halved. So tree
+ * depth is limited, and tree follows changes of the text.
+ */
+const int ADAPTIVE_MAX_WEIGHT = 1 << 16;
+
+/*
+ * Class: AdaptiveTree
+ * -------------------
+ * Huffman tree in flat array, where nodes are ordered by not
+ * increasing weights, and siblings are neighbours (sibling
+ * property). Root is the first node, children of node are
+ * child and child + 1 nodes, which are coded by bits 0 and 1.
+ * Leaf keeps its symbol in child field.
+ *
+ * After symbol weight increment, every node on the way to the
+ * root is swapped with the first node of the same weight, so
+ * tree stays Huffman tree of current weights.
+ */
+class AdaptiveTree {
+public:
+    /*
+     * Constructor: AdaptiveTree
+     * -------------------------
+     * Initial tree has PSEUDO_EOF and ADAPTIVE_ESCAPE leaves.
+     */
+    AdaptiveTree();
+
+    /*
+     * Method: encode
+     * Usage: tree.encode(byte, writer);
+     * ---------------------------------
+     * Writes code of byte value or PSEUDO_EOF, and updates tree.
+     */
+    void encode(int symbol, BitWriter& writer);
+
+    /*
+     * Method: decodeBit
+     * Usage: ext_char symbol = tree.decodeBit(bit);
+     * ---------------------------------------------
+     * Takes next bit of stream. Returns decoded byte value or
+     * PSEUDO_EOF, or NOT_A_CHAR if symbol code isn't finished.
+     * Tree is updated after every decoded symbol.
+     */
+    ext_char decodeBit(int bit);
+
+private:
+    struct TreeNode {
+        int weight;
+        int parent;
+        int child;
+        bool isLeaf;
+    };
+
+    TreeNode nodes[ADAPTIVE_NODES];
+    int leaves[ADAPTIVE_SYMBOLS];//Node of every symbol, or -1
+    int nextFree;
+
+    /* Decoder state */
+    int decodeNode;
+    int rawBitsLeft;
+    int rawSymbol;
+
+    void writeCode(int symbol, BitWriter& writer);
+    void addSymbol(int symbol);
+    void update(int symbol);
+    void swapNodes(int i, int j);
+    void rebuild();
+};
+
+/* Function: compressAdaptiveStream
+ * Usage: compressAdaptiveStream(cin, cout);
+ * -----------------------------------------
+ * Codes in stream up to its end into out. Whole coded bytes
+ * are flushed every time input has no ready data, so output
+ * doesn't wait for input end.
+ */
+void compressAdaptiveStream(std::istream& in, std::ostream& out);
+
+/* Function: decompressAdaptiveStream
+ * Usage: decompressAdaptiveStream(cin, cout);
+ * -------------------------------------------
+ * Decodes adaptive stream into out, and flushes decoded text
+ * every time input has no ready data.
+ */
+void decompressAdaptiveStream(std::istream& in, std::ostream& out);
+
+/* Function: isAdaptiveStream
+ * Usage: if (isAdaptiveStream(data, size)) ...
+ * --------------------------------------------
+ * Returns true if cypher file starts as adaptive stream.
+ */
+bool isAdaptiveStream(const char* data, size_t size);
+
+/* Function: compressAdaptive
+ * Usage: compressAdaptive(inputFile, cypherFile);
+ * -----------------------------------------------
+ * Compresses inputFile into cypherFile by adaptive coding.
+ * decompress() recognises such files.
+ */
+void compressAdaptive(std::string inputFile, std::string cypherFile);
+
+#endif
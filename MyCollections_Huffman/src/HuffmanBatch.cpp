@@ -0,0 +1,352 @@
+/**********************************************************
+* File: HuffmanBatch.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - files with the same output path fail, but the first one
+*
+* Implementation of the functions from HuffmanBatch.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include "error.h"
+#include "filelib.h"
+#include "HuffmanBatch.h"
+#include "HuffmanBuffer.h"
+#include "HuffmanTypes.h"
+#include "mappedfile.h"
+#include "strlib.h"
+#include "threadpool.h"
+
+using namespace std;
+
+/* Type: BatchJob
+ * Files, which are coded by one thread one after another.
+ */
+struct BatchJob {
+    vector<int> files;
+    long long size;
+};
+
+/* Type: BatchTotal
+ * Sums of done files and lock of report, as every thread
+ * writes its lines by itself.
+ */
+struct BatchTotal {
+    mutex reportMutex;
+    int doneCount;
+    int failedCount;
+    long long inSize;
+    long long outSize;
+};
+
+/*
+ * Class: FileSink
+ * ---------------
+ * Sink, which writes into file stream.
+ */
+class FileSink : public OutputSink {
+public:
+    FileSink(ostream& out, const string& fileName) : out(out), fileName(fileName) {
+    }
+
+    void write(const char* bytes, size_t size) {
+        out.write(bytes, size);
+        if (!out) error("Can't write file \"" + fileName + "\"");
+    }
+
+private:
+    ostream& out;
+    const string& fileName;
+};
+
+/* Function: getFileSize
+ * ---------------------
+ * Returns size of file, or -1 if it can't be opened.
+ */
+static long long getFileSize(const string& path) {
+    ifstream in(path.c_str(), ios::binary | ios::ate);
+    if (!in.is_open()) return -1;
+    return (long long) in.tellg();
+}
+
+/* Function: addDirectoryFiles
+ * ---------------------------
+ * Adds files of dir and of its subdirectories. Linked
+ * directories are not entered, so links can't make loops.
+ */
+static void addDirectoryFiles(const string& dir, const string& prefix, vector<BatchFile>& files) {
+    vector<string> names;
+    listDirectory(dir, names);
+    for (const string& name : names) {
+        string path = dir + "/" + name;
+        if (isDirectory(path)) {
+            if (!isSymbolicLink(path)) {
+                addDirectoryFiles(path, prefix + name + "/", files);
+            }
+        } else if (isFile(path)) {
+            BatchFile file;
+            file.path = path;
+            file.name = prefix + name;
+            file.size = getFileSize(path);
+            files.push_back(file);
+        }
+    }
+}
+
+/* Function: addListedFiles
+ * ------------------------
+ * Adds every not empty line of list as file path.
+ */
+static void addListedFiles(istream& list, vector<BatchFile>& files) {
+    string line;
+    while (getline(list, line)) {
+        if (!line.empty() && (line[line.size() - 1] == '\r')) {
+            line.erase(line.size() - 1);
+        }
+        if (line.empty()) continue;
+        BatchFile file;
+        file.path = line;
+        file.name = getTail(line);
+        file.size = getFileSize(line);
+        files.push_back(file);
+    }
+}
+
+vector<BatchFile> listBatchFiles(const string& input) {
+    vector<BatchFile> files;
+    if (input == "-") {
+        addListedFiles(cin, files);
+    } else if (isDirectory(input)) {
+        addDirectoryFiles(input, "", files);
+    } else {
+        ifstream list(input.c_str());
+        if (!list.is_open()) error("Can't read file list \"" + input + "\"");
+        addListedFiles(list, files);
+    }
+    return files;
+}
+
+/* Function: getOutputPath
+ * -----------------------
+ * Returns path of coded file in outDir.
+ */
+static string getOutputPath(const BatchFile& file, const string& outDir, bool isCompress) {
+    string name = file.name;
+    if (isCompress) {
+        name += BATCH_CYPHER_EXTENSION;
+    } else if (endsWith(name, BATCH_CYPHER_EXTENSION)
+               && (name.size() > BATCH_CYPHER_EXTENSION.size())) {
+        name.erase(name.size() - BATCH_CYPHER_EXTENSION.size());
+    } else {
+        name += ".out";
+    }
+    return outDir + "/" + name;
+}
+
+/* Function: makeDirectories
+ * -------------------------
+ * Makes directory of path with all its parents.
+ */
+static void makeDirectories(const string& path) {
+    size_t slash = 0;
+    while (slash != string::npos) {
+        slash = path.find('/', slash + 1);
+        string dir = path.substr(0, slash);
+        if (!dir.empty() && !isDirectory(dir)) {
+            createDirectory(dir);
+        }
+    }
+}
+
+/* Function: makeJobs
+ * ------------------
+ * Every file of BATCH_JOB_SIZE or bigger is job by itself,
+ * smaller ones are packed into jobs of about that size.
+ * Biggest jobs go first, so the last jobs are small and
+ * threads end at about the same time.
+ */
+static vector<BatchJob> makeJobs(const vector<BatchFile>& files, const vector<int>& numbers) {
+    vector<int> order = numbers;
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return files[a].size > files[b].size;
+    });
+    vector<BatchJob> jobs;
+    BatchJob packed;
+    packed.size = 0;
+    for (int number : order) {
+        long long size = max(0LL, files[number].size);
+        if (size >= BATCH_JOB_SIZE) {
+            BatchJob job;
+            job.files.push_back(number);
+            job.size = size;
+            jobs.push_back(job);
+            continue;
+        }
+        packed.files.push_back(number);
+        packed.size += size;
+        if (packed.size >= BATCH_JOB_SIZE) {
+            jobs.push_back(packed);
+            packed.files.clear();
+            packed.size = 0;
+        }
+    }
+    if (!packed.files.empty()) {
+        jobs.push_back(packed);
+    }
+    return jobs;
+}
+
+/* Function: reportFile
+ * --------------------
+ * Adds file to total and writes its line: sizes, ratio and
+ * time, or error if failure isn't empty.
+ */
+static void reportFile(const BatchFile& file, const string& failure, long long inSize,
+                       long long outSize, double seconds, bool isCompress,
+                       BatchTotal& total, ostream& report) {
+    ostringstream line;
+    line.setf(ios::fixed);
+    if (failure.empty()) {
+        long long textSize = isCompress ? inSize : outSize;
+        long long cypherSize = isCompress ? outSize : inSize;
+        line.precision(4);
+        line << file.name << ": " << inSize << " -> " << outSize << " bytes, ratio "
+             << ((textSize > 0) ? (double) cypherSize / textSize : 0.0);
+        line.precision(2);
+        line << ", " << seconds * 1000 << " ms" << endl;
+    } else {
+        line << file.name << ": FAILED - " << failure << endl;
+    }
+
+    lock_guard<mutex> lock(total.reportMutex);
+    if (failure.empty()) {
+        total.doneCount++;
+        total.inSize += inSize;
+        total.outSize += outSize;
+    } else {
+        total.failedCount++;
+    }
+    report << line.str();
+    report.flush();
+}
+
+/* Function: codeFile
+ * ------------------
+ * Codes one file by threadCount threads and writes its
+ * report line. Error of file is reported and not thrown.
+ */
+static void codeFile(const BatchFile& file, const string& outPath, bool isCompress,
+                     int threadCount, BlockCoding coding, BatchTotal& total, ostream& report) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    long long inSize = 0;
+    long long outSize = 0;
+    string failure;
+    try {
+        MappedFile input(file.path);
+        if (!input.isOpen()) error("Can't read file \"" + file.path + "\"");
+        ofstream out(outPath.c_str(), ios::binary);
+        if (!out.is_open()) error("Can't write file \"" + outPath + "\"");
+        FileSink sink(out, outPath);
+        inSize = input.size();
+        if (isCompress) {
+            outSize = compressBuffer(input.data(), input.size(), sink, MAX_CODE_LENGTH,
+                                     threadCount, coding);
+        } else {
+            outSize = decompressBuffer(input.data(), input.size(), sink, threadCount);
+        }
+        out.close();
+        if (out.fail()) error("Can't write file \"" + outPath + "\"");
+    } catch (ErrorException& e) {
+        failure = e.getMessage();
+    } catch (exception& e) {
+        failure = e.what();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    reportFile(file, failure, inSize, outSize, seconds, isCompress, total, report);
+}
+
+/* Function: runBatch
+ * ------------------
+ * Large files use the whole pool by blocks. Other files are
+ * jobs of pool, where every thread takes the next job as
+ * soon as it's free, so slow jobs don't hold up others.
+ * Every job codes its files by single thread, which starts
+ * no threads of its own. Files are coded at the same time,
+ * so two of them must not write one output file: only the
+ * first file of every output path is coded.
+ */
+int runBatch(const vector<BatchFile>& files, const string& outDir, bool isCompress,
+             int threadCount, BlockCoding coding, ostream& report) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<string> outPaths;
+    map<string, int> outputOwners;
+    set<string> dirs;
+    vector<int> duplicates;
+    vector<int> large;
+    vector<int> pooled;
+    for (int i = 0; i < (int) files.size(); i++) {
+        outPaths.push_back(getOutputPath(files[i], outDir, isCompress));
+        if (outputOwners.count(outPaths[i]) > 0) {
+            duplicates.push_back(i);
+            continue;
+        }
+        outputOwners[outPaths[i]] = i;
+        dirs.insert(getHead(outPaths[i]));
+        if (files[i].size >= BATCH_LARGE_FILE_SIZE) {
+            large.push_back(i);
+        } else {
+            pooled.push_back(i);
+        }
+    }
+    for (const string& dir : dirs) {
+        makeDirectories(dir);
+    }
+
+    BatchTotal total;
+    total.doneCount = 0;
+    total.failedCount = 0;
+    total.inSize = 0;
+    total.outSize = 0;
+    for (int number : duplicates) {
+        const BatchFile& owner = files[outputOwners[outPaths[number]]];
+        reportFile(files[number], "\"" + files[number].path + "\" has the same output file \""
+                   + outPaths[number] + "\" as \"" + owner.path + "\"",
+                   0, 0, 0, isCompress, total, report);
+    }
+    for (int number : large) {
+        codeFile(files[number], outPaths[number], isCompress, threadCount, coding, total, report);
+    }
+    vector<BatchJob> jobs = makeJobs(files, pooled);
+    ThreadPool pool(threadCount);
+    pool.run(jobs.size(), [&](int job) {
+        for (int number : jobs[job].files) {
+            codeFile(files[number], outPaths[number], isCompress, 1, coding, total, report);
+        }
+    });
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long textSize = isCompress ? total.inSize : total.outSize;
+    long long cypherSize = isCompress ? total.outSize : total.inSize;
+    ostringstream line;
+    line.setf(ios::fixed);
+    line << "Total: " << total.doneCount << " files, " << total.failedCount << " failed, "
+         << total.inSize << " -> " << total.outSize << " bytes, ratio ";
+    line.precision(4);
+    line << ((textSize > 0) ? (double) cypherSize / textSize : 0.0);
+    line.precision(2);
+    line << ", " << seconds << " s, "
+         << ((seconds > 0) ? textSize / seconds / 1e6 : 0.0) << " MB/s" << endl;
+    report << line.str();
+    report.flush();
+    return total.failedCount;
+}
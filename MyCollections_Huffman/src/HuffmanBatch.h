@@ -0,0 +1,80 @@
+/*******************************************************
+* File: HuffmanBatch.h
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - files of the same output path are failed
+*
+* Compression and decompression of many files at once:
+* whole directory or list of files. Files are coded by
+* pool of threads, one file for one thread, and result
+* of every file is reported as soon as it's done.
+*******************************************************/
+
+#ifndef HuffmanBatch_Included
+#define HuffmanBatch_Included
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "HuffmanBlocks.h"
+
+/* Constant: BATCH_JOB_SIZE
+ * Files smaller then this are packed together into jobs of
+ * about this size, so thread takes many small files at
+ * once instead of paying for every one of them.
+ */
+const long long BATCH_JOB_SIZE = 1 << 20;
+
+/* Constant: BATCH_LARGE_FILE_SIZE
+ * Files of this size and bigger are coded one by one by
+ * all threads of pool, by blocks, before other files.
+ */
+const long long BATCH_LARGE_FILE_SIZE = 64LL << 20;
+
+/* Constant: BATCH_CYPHER_EXTENSION
+ * Extension of compressed files, which decompression
+ * takes off.
+ */
+const std::string BATCH_CYPHER_EXTENSION = ".huf";
+
+/* Type: BatchFile
+ * File of batch: its path, name relative to the batch
+ * input, which is kept in output directory, and size.
+ */
+struct BatchFile {
+    std::string path;
+    std::string name;
+    long long size;
+};
+
+/* Function: listBatchFiles
+ * Usage: std::vector<BatchFile> files = listBatchFiles(input);
+ * ------------------------------------------------------------
+ * Returns files of input. Directory gives all its files and
+ * files of subdirectories with names relative to it. Other
+ * input is list file with one path on every line, "-" is
+ * list from standard input; name of listed file is its
+ * last path part. Reports error if input can't be read.
+ */
+std::vector<BatchFile> listBatchFiles(const std::string& input);
+
+/* Function: runBatch
+ * Usage: int failed = runBatch(files, outDir, true, 0, INTERLEAVED_BLOCKS, cout);
+ * -------------------------------------------------------------------------------
+ * Compresses (isCompress) or decompresses every file into
+ * outDir by threadCount threads (0 - by all hardware ones).
+ * Compressed file gets BATCH_CYPHER_EXTENSION, decompressed
+ * one loses it or gets ".out" otherwise. Line of every done
+ * file is written into report: name, sizes, ratio and time;
+ * failed file gets line with its error, and other files go
+ * on. Files, whose output path is the same as of previous
+ * file - listed files of one name from different folders -
+ * fail without coding. The last line is total. Returns
+ * count of failed files.
+ */
+int runBatch(const std::vector<BatchFile>& files, const std::string& outDir, bool isCompress,
+             int threadCount, BlockCoding coding, std::ostream& report);
+
+#endif
@@ -0,0 +1,462 @@
+/**********************************************************
+* File: HuffmanBenchmark.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - all forms of new and delete are replaced, allocations
+*   are counted only during measuring
+* - tree phase reads only BYTE_VALUES counts of every block
+*
+* v.3 2026/10/18
+* - new and delete are replaced only in benchmark build
+* - peak RSS is reported once for the whole run
+*
+* Implementation of the functions from HuffmanBenchmark.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include "error.h"
+#include "HuffmanBenchmark.h"
+#include "HuffmanBuffer.h"
+#include "HuffmanEncoding.h"
+#include "HuffmanHistogram.h"
+#include "mappedfile.h"
+#include "strlib.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+/* Constant: RES_FILES
+ * Texts of res folder, which are measured by default.
+ */
+static const char* const RES_FILES[] = {"tomSawyer.txt", "poem", "fibonacci", "singleChar"};
+static const int RES_FILES_COUNT = 4;
+
+/* Counters of heap allocations, which are counted only
+ * while benchmark measures them */
+static atomic<bool> isCounting(false);
+static atomic<long long> allocationCount(0);
+static atomic<long long> allocatedBytes(0);
+
+#ifdef HUFFMAN_COUNT_ALLOCATIONS
+
+/* Constant: IS_COUNTING_ALLOCATIONS
+ * Allocations are counted only by benchmark build, which
+ * HuffmanBenchmark.pro makes.
+ */
+static const bool IS_COUNTING_ALLOCATIONS = true;
+
+/* Functions: operator new, operator delete
+ * ----------------------------------------
+ * Replacements of global allocation, which count allocations
+ * while isCounting is set. They are built only by benchmark
+ * build, so other builds keep allocator of library. Every
+ * form is replaced - plain, array, nothrow and sized - so
+ * that any new and delete pair goes to malloc and free,
+ * whichever forms library mixes.
+ */
+static void* countedAllocate(size_t size) {
+    if (isCounting.load(memory_order_relaxed)) {
+        allocationCount.fetch_add(1, memory_order_relaxed);
+        allocatedBytes.fetch_add(size, memory_order_relaxed);
+    }
+    return malloc((size > 0) ? size : 1);
+}
+
+void* operator new(size_t size) {
+    void* memory = countedAllocate(size);
+    if (memory == NULL) throw bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, const nothrow_t&) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, const nothrow_t&) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    free(memory);
+}
+
+#else
+
+static const bool IS_COUNTING_ALLOCATIONS = false;
+
+#endif
+
+/* Function: nextRandom
+ * --------------------
+ * Xorshift generator, the same texts for the same seed
+ * on every platform.
+ */
+static unsigned nextRandom(unsigned& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+vector<char> generateUniformText(size_t size, unsigned seed) {
+    vector<char> text(size);
+    unsigned state = seed | 1;
+    for (size_t i = 0; i < size; i++) {
+        text[i] = (char) (nextRandom(state) >> 24);
+    }
+    return text;
+}
+
+/* Function: generateZipfText
+ * --------------------------
+ * Bytes are taken by binary search of random number in
+ * cumulative probabilities of ranks.
+ */
+vector<char> generateZipfText(size_t size, unsigned seed) {
+    double limits[BYTE_VALUES];
+    double sum = 0;
+    for (int rank = 0; rank < BYTE_VALUES; rank++) {
+        sum += 1.0 / (rank + 1);
+        limits[rank] = sum;
+    }
+    unsigned thresholds[BYTE_VALUES];
+    for (int rank = 0; rank < BYTE_VALUES; rank++) {
+        thresholds[rank] = (unsigned) (limits[rank] / sum * 4294967295.0);
+    }
+    thresholds[BYTE_VALUES - 1] = 4294967295u;
+
+    vector<char> text(size);
+    unsigned state = seed | 1;
+    for (size_t i = 0; i < size; i++) {
+        unsigned value = nextRandom(state);
+        text[i] = (char) (lower_bound(thresholds, thresholds + BYTE_VALUES, value) - thresholds);
+    }
+    return text;
+}
+
+/* Function: bestSeconds
+ * ---------------------
+ * Runs task repeat times and returns time of the fastest run.
+ */
+template <typename Task>
+static double bestSeconds(int repeat, Task task) {
+    double best = 0;
+    for (int run = 0; run < repeat; run++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        task();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if ((run == 0) || (seconds < best)) {
+            best = seconds;
+        }
+    }
+    return best;
+}
+
+/* Function: megabytesPerSecond
+ * ----------------------------
+ * Returns speed of size bytes in seconds, 0 if it's too
+ * fast for the clock.
+ */
+static double megabytesPerSecond(size_t size, double seconds) {
+    return (seconds > 0) ? size / seconds / 1e6 : 0;
+}
+
+/* Function: peakRssKilobytes
+ * --------------------------
+ * Returns the biggest resident memory of process so far.
+ * It's high-water mark of the whole process, which can't
+ * be reset, so it's taken once after all texts.
+ */
+static long long peakRssKilobytes() {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/* Function: jsonString
+ * --------------------
+ * Returns text as JSON string with quotes.
+ */
+static string jsonString(const string& text) {
+    ostringstream result;
+    result << '"';
+    for (char ch : text) {
+        if ((ch == '"') || (ch == '\\')) {
+            result << '\\' << ch;
+        } else if ((unsigned char) ch < 0x20) {
+            result << "\\u00" << "0123456789abcdef"[(ch >> 4) & 0xF] << "0123456789abcdef"[ch & 0xF];
+        } else {
+            result << ch;
+        }
+    }
+    result << '"';
+    return result.str();
+}
+
+/* Function: codingName
+ * ---------------------
+ * Returns name of blocks coding as option of command line.
+ */
+static string codingName(BlockCoding coding) {
+    switch (coding) {
+    case SINGLE_STREAM_BLOCKS: return "single";
+    case RANS_BLOCKS: return "rans";
+    case LZ77_BLOCKS: return "lz77";
+    case CONTEXT_BLOCKS: return "context";
+    default: return "interleaved";
+    }
+}
+
+/* Type: BenchmarkResult
+ * Numbers of one text.
+ */
+struct BenchmarkResult {
+    string name;
+    size_t size;
+    size_t compressedSize;
+    double histogramSpeed;
+    double treeSpeed;
+    double encodeSpeed;
+    double decodeSpeed;
+    double compressSpeed;
+    double decompressSpeed;
+    long long compressAllocations;
+    long long compressAllocatedBytes;
+    long long decompressAllocations;
+    long long decompressAllocatedBytes;
+};
+
+/* Function: measureText
+ * ---------------------
+ * Measures all phases of one text. Block phases run in
+ * current thread, compress and decompress - by all threads.
+ */
+static BenchmarkResult measureText(const string& name, const unsigned char* text, size_t size,
+                                   const BenchmarkOptions& options) {
+    BenchmarkResult result;
+    result.name = name;
+    result.size = size;
+    int repeat = max(1, options.repeat);
+
+    /* Histogram */
+    long long counts[BYTE_VALUES];
+    result.histogramSpeed = megabytesPerSecond(size, bestSeconds(repeat, [&] {
+        fill(counts, counts + BYTE_VALUES, 0);
+        countBytes(text, size, counts);
+    }));
+
+    /* Code lengths of every block */
+    size_t blockCount = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    vector<long long> blockCounts(blockCount * BYTE_VALUES, 0);
+    for (size_t i = 0; i < blockCount; i++) {
+        size_t offset = i * BLOCK_SIZE;
+        countBytes(text + offset, min((size_t) BLOCK_SIZE, size - offset),
+                   &blockCounts[i * BYTE_VALUES]);
+    }
+    result.treeSpeed = megabytesPerSecond(size, bestSeconds(repeat, [&] {
+        for (size_t i = 0; i < blockCount; i++) {
+            getCodeLengths(&blockCounts[i * BYTE_VALUES], MAX_CODE_LENGTH);
+        }
+    }));
+
+    /* Block data */
+    vector<vector<char> > blocks(blockCount);
+    result.encodeSpeed = megabytesPerSecond(size, bestSeconds(repeat, [&] {
+        for (size_t i = 0; i < blockCount; i++) {
+            size_t offset = i * BLOCK_SIZE;
+            blocks[i].clear();
+            encodeBlock(text + offset, min((size_t) BLOCK_SIZE, size - offset),
+                        MAX_CODE_LENGTH, blocks[i], options.coding);
+        }
+    }));
+    vector<char> decoded(size);
+    result.decodeSpeed = megabytesPerSecond(size, bestSeconds(repeat, [&] {
+        for (size_t i = 0; i < blockCount; i++) {
+            size_t offset = i * BLOCK_SIZE;
+            decodeBlock(blocks[i].data(), blocks[i].size(), &decoded[offset],
+                        min((size_t) BLOCK_SIZE, size - offset), options.coding);
+        }
+    }));
+    if (!equal(decoded.begin(), decoded.end(), (const char*) text)) {
+        error("runBenchmark: Blocks of \"" + name + "\" are decoded wrong");
+    }
+
+    /* The whole container */
+    vector<char> cypher;
+    result.compressSpeed = megabytesPerSecond(size, bestSeconds(repeat, [&] {
+        cypher.clear();
+        VectorSink sink(cypher);
+        compressBuffer(text, size, sink, MAX_CODE_LENGTH, 0, options.coding);
+    }));
+    result.compressedSize = cypher.size();
+    const uint8_t* cypherData = (const uint8_t*) cypher.data();
+    result.decompressSpeed = megabytesPerSecond(size, bestSeconds(repeat, [&] {
+        MemorySink sink((uint8_t*) decoded.data(), size);
+        decompressBuffer(cypherData, cypher.size(), sink);
+    }));
+    if (!equal(decoded.begin(), decoded.end(), (const char*) text)) {
+        error("runBenchmark: \"" + name + "\" is decompressed wrong");
+    }
+
+    /* Allocations of one more run, output buffer is ready before */
+    cypher.clear();
+    isCounting.store(true);
+    long long countBefore = allocationCount.load();
+    long long bytesBefore = allocatedBytes.load();
+    {
+        VectorSink sink(cypher);
+        compressBuffer(text, size, sink, MAX_CODE_LENGTH, 0, options.coding);
+    }
+    result.compressAllocations = allocationCount.load() - countBefore;
+    result.compressAllocatedBytes = allocatedBytes.load() - bytesBefore;
+    countBefore = allocationCount.load();
+    bytesBefore = allocatedBytes.load();
+    {
+        MemorySink sink((uint8_t*) decoded.data(), size);
+        decompressBuffer(cypherData, cypher.size(), sink);
+    }
+    result.decompressAllocations = allocationCount.load() - countBefore;
+    result.decompressAllocatedBytes = allocatedBytes.load() - bytesBefore;
+    isCounting.store(false);
+    return result;
+}
+
+/* Function: allocationsJson
+ * -------------------------
+ * Returns count as JSON number, or null if allocations
+ * are not counted by this build.
+ */
+static string allocationsJson(long long count) {
+    return IS_COUNTING_ALLOCATIONS ? longToString(count) : string("null");
+}
+
+/* Function: writeResult
+ * ---------------------
+ * Writes one text result as JSON object.
+ */
+static void writeResult(const BenchmarkResult& result, ostream& out) {
+    ostringstream json;
+    json.setf(ios::fixed);
+    json.precision(2);
+    double ratio = (result.size > 0) ? (double) result.compressedSize / result.size : 0;
+    json << "    {" << endl;
+    json << "      \"name\": " << jsonString(result.name) << "," << endl;
+    json << "      \"size\": " << result.size << "," << endl;
+    json << "      \"compressedSize\": " << result.compressedSize << "," << endl;
+    json.precision(4);
+    json << "      \"ratio\": " << ratio << "," << endl;
+    json.precision(2);
+    json << "      \"histogramMBps\": " << result.histogramSpeed << "," << endl;
+    json << "      \"treeMBps\": " << result.treeSpeed << "," << endl;
+    json << "      \"encodeMBps\": " << result.encodeSpeed << "," << endl;
+    json << "      \"decodeMBps\": " << result.decodeSpeed << "," << endl;
+    json << "      \"compressMBps\": " << result.compressSpeed << "," << endl;
+    json << "      \"decompressMBps\": " << result.decompressSpeed << "," << endl;
+    json << "      \"compressAllocations\": "
+         << allocationsJson(result.compressAllocations) << "," << endl;
+    json << "      \"compressAllocatedBytes\": "
+         << allocationsJson(result.compressAllocatedBytes) << "," << endl;
+    json << "      \"decompressAllocations\": "
+         << allocationsJson(result.decompressAllocations) << "," << endl;
+    json << "      \"decompressAllocatedBytes\": "
+         << allocationsJson(result.decompressAllocatedBytes) << endl;
+    json << "    }";
+    out << json.str();
+}
+
+/* Function: runBenchmark
+ * ----------------------
+ * Results are written as soon as every text is measured,
+ * so long runs show progress. Missing res files are skipped,
+ * missing files of user are errors.
+ */
+void runBenchmark(const BenchmarkOptions& options, ostream& out) {
+    vector<string> files = options.files;
+    bool isDefault = files.empty();
+    if (isDefault) {
+        files.assign(RES_FILES, RES_FILES + RES_FILES_COUNT);
+    }
+
+    out << "{" << endl;
+    out << "  \"coding\": " << jsonString(codingName(options.coding)) << "," << endl;
+    out << "  \"repeat\": " << max(1, options.repeat) << "," << endl;
+    out << "  \"results\": [" << endl;
+    bool isFirst = true;
+    for (const string& file : files) {
+        MappedFile input(file);
+        if (!input.isOpen()) {
+            if (isDefault) {
+                cerr << "runBenchmark: \"" << file << "\" is skipped, it's not found" << endl;
+                continue;
+            }
+            error("runBenchmark: Can't read file \"" + file + "\"");
+        }
+        BenchmarkResult result = measureText(file, input.data(), input.size(), options);
+        out << (isFirst ? "" : ",\n");
+        writeResult(result, out);
+        out.flush();
+        isFirst = false;
+    }
+
+    if (options.generatedSize > 0) {
+        size_t size = (size_t) options.generatedSize << 20;
+        string suffix = "-" + integerToString((int) options.generatedSize) + "MB";
+        for (int kind = 0; kind < 2; kind++) {
+            vector<char> text = (kind == 0) ? generateUniformText(size, 1)
+                                            : generateZipfText(size, 2);
+            BenchmarkResult result = measureText((kind == 0 ? "uniform" : "zipf") + suffix,
+                                                 (const unsigned char*) text.data(), size, options);
+            out << (isFirst ? "" : ",\n");
+            writeResult(result, out);
+            out.flush();
+            isFirst = false;
+        }
+    }
+    out << endl << "  ]," << endl;
+    out << "  \"peakRssKB\": " << peakRssKilobytes() << endl;
+    out << "}" << endl;
+}
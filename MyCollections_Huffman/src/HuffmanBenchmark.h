@@ -0,0 +1,87 @@
+/*******************************************************
+* File: HuffmanBenchmark.h
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - peak RSS is reported for the whole run, allocations are
+*   counted only by benchmark build
+*
+* Benchmark of the codec over files and generated texts.
+* Every phase of block coding is timed on its own, and
+* the whole in-memory compression too, so regression of
+* any step is seen in numbers. Results are written as JSON.
+*******************************************************/
+
+#ifndef HuffmanBenchmark_Included
+#define HuffmanBenchmark_Included
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "HuffmanBlocks.h"
+
+/* Constant: BENCHMARK_DEFAULT_SIZE
+ * Size of every generated text by default, in megabytes.
+ */
+const int BENCHMARK_DEFAULT_SIZE = 16;
+
+/* Constant: BENCHMARK_DEFAULT_REPEAT
+ * Count of runs of every phase. The fastest run counts.
+ */
+const int BENCHMARK_DEFAULT_REPEAT = 3;
+
+/* Type: BenchmarkOptions
+ * What is measured:
+ * - files - texts from disk, res files if it's empty;
+ * - generatedSize - size of uniform random and Zipf texts
+ *   in megabytes, 0 - no generated texts; thousands of
+ *   megabytes give multi-GB run;
+ * - repeat - count of runs of every phase;
+ * - coding - blocks coding of encode and decode phases.
+ */
+struct BenchmarkOptions {
+    std::vector<std::string> files;
+    long long generatedSize;
+    int repeat;
+    BlockCoding coding;
+
+    BenchmarkOptions() : generatedSize(BENCHMARK_DEFAULT_SIZE),
+        repeat(BENCHMARK_DEFAULT_REPEAT), coding(INTERLEAVED_BLOCKS) {
+    }
+};
+
+/* Function: generateUniformText
+ * Usage: std::vector<char> text = generateUniformText(size, seed);
+ * ----------------------------------------------------------------
+ * Returns size bytes of uniform random bytes - text, which
+ * can't be compressed.
+ */
+std::vector<char> generateUniformText(size_t size, unsigned seed);
+
+/* Function: generateZipfText
+ * Usage: std::vector<char> text = generateZipfText(size, seed);
+ * -------------------------------------------------------------
+ * Returns size random bytes of skewed distribution: byte of
+ * rank k has probability proportional to 1 / k.
+ */
+std::vector<char> generateZipfText(size_t size, unsigned seed);
+
+/* Function: runBenchmark
+ * Usage: runBenchmark(options, cout);
+ * -----------------------------------
+ * Measures every text of options and writes JSON report
+ * into out. For every text it has MB/s of phases:
+ * histogram - byte counts, tree - code lengths of blocks,
+ * encode and decode - block data, compress and decompress -
+ * the whole container in memory; then compression ratio,
+ * count and bytes of heap allocations of compress and
+ * decompress. Allocations are counted only by benchmark
+ * build of HuffmanBenchmark.pro, other builds write null.
+ * Peak RSS of process is written once after all texts.
+ * Reports error, if text isn't decoded back right.
+ */
+void runBenchmark(const BenchmarkOptions& options, std::ostream& out);
+
+#endif
@@ -0,0 +1,893 @@
+/**********************************************************
+* File: HuffmanBlocks.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - decoding of text range by block index
+* - block headers are checked only for decoded blocks
+*
+* v.3 2026/10/18
+* - streaming coding with bounded memory
+*
+* v.4 2026/10/18
+* - interleaved blocks
+*
+* v.5 2026/10/18
+* - tree is built on the stack of coding thread
+*
+* v.6 2026/10/18
+* - code lengths are found without tree
+*
+* v.7 2026/10/18
+* - rANS blocks
+*
+* v.8 2026/10/18
+* - LZ77 blocks
+*
+* v.9 2026/10/18
+* - order-1 context blocks
+*
+* v.10 2026/10/18
+* - typed blocks, incompressible blocks are stored
+*
+* v.11 2026/10/18
+* - reading, coding and writing run in pipeline threads
+*
+* v.12 2026/10/18
+* - text of one group is written without writer thread
+*
+* v.13 2026/10/18
+* - index entries bigger then block size are rejected
+*
+* v.14 2026/10/18
+* - failed writing of output stream is reported
+*
+* v.15 2026/10/18
+* - block size of container and block sizes are checked
+*   before anything is allocated, empty blocks are rejected
+*
+* v.16 2026/10/18
+* - text of one block is stored as it is, if its container
+*   would be longer
+*
+* Implementation of the functions from HuffmanBlocks.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include <limits>
+#include "error.h"
+#include "HuffmanBlocks.h"
+#include "HuffmanEncoding.h"
+#include "HuffmanDecoding.h"
+#include "HuffmanHistogram.h"
+#include "HuffmanRans.h"
+#include "HuffmanLz77.h"
+#include "HuffmanContext.h"
+#include "pipeline.h"
+
+using namespace std;
+
+/* Constant: BLOCKS_PER_THREAD
+ * Count of blocks for every thread in one group. Group
+ * is kept in memory until it's written in order.
+ */
+static const int BLOCKS_PER_THREAD = 4;
+
+/* Constant: PIPELINE_CHUNKS
+ * Count of groups in every ring between pipeline stages:
+ * one is filled, while the other one is used.
+ */
+static const int PIPELINE_CHUNKS = 2;
+
+/* Type: Chunk
+ * Bytes of one group, which go between pipeline stages.
+ */
+typedef vector<char> Chunk;
+
+/* Functions: putNumber, getNumber
+ * -------------------------------
+ * Store and load byteCount bytes of little-endian number.
+ */
+static void putNumber(vector<char>& bytes, unsigned long long value, int byteCount) {
+    for (int i = 0; i < byteCount; i++) {
+        bytes.push_back((char) (value >> (8 * i)));
+    }
+}
+
+static unsigned long long getNumber(const char* bytes, int byteCount) {
+    unsigned long long value = 0;
+    for (int i = 0; i < byteCount; i++) {
+        value |= (unsigned long long) (unsigned char) bytes[i] << (8 * i);
+    }
+    return value;
+}
+
+/* Function: encodeBlock
+ * ---------------------
+ * The same steps as compress() had for the whole text:
+ * frequencies, limited Huffman code lengths, and then codes
+ * of the text. Code lengths are taken from counts in place,
+ * so no tree and no priority queue are built. Counts
+ * of the text are taken from caller, who has them already.
+ */
+static void encodeCountedBlock(const unsigned char* text, size_t size, const long long* counts,
+                               int maxCodeLength, vector<char>& data, BlockCoding coding) {
+    if (coding == RANS_BLOCKS) {
+        encodeRansBlock(text, size, data);
+        return;
+    }
+    if (coding == LZ77_BLOCKS) {
+        encodeLz77Block(text, size, maxCodeLength, data);
+        return;
+    }
+    if (coding == CONTEXT_BLOCKS) {
+        encodeContextBlock(text, size, maxCodeLength, data);
+        return;
+    }
+    CodeLengths lengths = getCodeLengths(counts, maxCodeLength);
+
+    {
+        BitWriter writer(data);
+        encodeCodeLengths(lengths, writer);
+        if (coding == SINGLE_STREAM_BLOCKS) {
+            encodeMainTextToFile(text, size, lengths, writer);
+        }
+    }
+    if (coding == INTERLEAVED_BLOCKS) {
+        encodeInterleavedText(text, size, lengths, data);
+    }
+}
+
+void encodeBlock(const unsigned char* text, size_t size,
+                 int maxCodeLength, vector<char>& data, BlockCoding coding) {
+    long long counts[BYTE_VALUES] = {0};
+    countBytes(text, size, counts);
+    encodeCountedBlock(text, size, counts, maxCodeLength, data, coding);
+}
+
+/* Function: estimateCodedSize
+ * ---------------------------
+ * Returns estimate of block data size by entropy of counts,
+ * with code lengths header of presentCount symbols.
+ */
+static double estimateCodedSize(const long long* counts, int presentCount) {
+    return (histogramBits(counts) + CODE_TABLE_SIZE
+            + presentCount * HEADER_LENGTH_BITS) / 8;
+}
+
+/* Function: encodeTypedBlock
+ * --------------------------
+ * Histogram is counted once, for the estimate and for codes.
+ */
+void encodeTypedBlock(const unsigned char* text, size_t size,
+                      int maxCodeLength, vector<char>& data, BlockCoding coding) {
+    long long counts[BYTE_VALUES] = {0};
+    countBytes(text, size, counts);
+    int presentCount = 0;
+    for (int value = 0; value < BYTE_VALUES; value++) {
+        if (counts[value] > 0) presentCount++;
+    }
+    if (presentCount == 1) {
+        data.push_back((char) RUN_BLOCK);
+        data.push_back((char) text[0]);
+        return;
+    }
+
+    size_t start = data.size();
+    bool isOrderZero = (coding != LZ77_BLOCKS) && (coding != CONTEXT_BLOCKS);
+    if ((size > 0) && (!isOrderZero
+            || (estimateCodedSize(counts, presentCount) < size * CODED_BLOCK_MAX_RATIO))) {
+        data.push_back((char) CODED_BLOCK);
+        encodeCountedBlock(text, size, counts, maxCodeLength, data, coding);
+        if (data.size() - start <= size) return;
+        data.resize(start);
+    }
+    data.push_back((char) STORED_BLOCK);
+    data.insert(data.end(), text, text + size);
+}
+
+void decodeBlock(const char* data, size_t dataSize, char* text, size_t textSize,
+                 BlockCoding coding) {
+    if (coding == RANS_BLOCKS) {
+        if (!decodeRansBlock(data, dataSize, text, textSize)) {
+            error("decodeBlock: Block text is broken");
+        }
+        return;
+    }
+    if (coding == LZ77_BLOCKS) {
+        if (!decodeLz77Block(data, dataSize, text, textSize)) {
+            error("decodeBlock: Block text is broken");
+        }
+        return;
+    }
+    if (coding == CONTEXT_BLOCKS) {
+        if (!decodeContextBlock(data, dataSize, text, textSize)) {
+            error("decodeBlock: Block text is broken");
+        }
+        return;
+    }
+    BitReader reader(data, dataSize);
+    CodeLengths lengths;
+    if (!readCodeLengths(reader, lengths)) {
+        error("decodeBlock: Block code lengths are broken");
+    }
+    if (coding == INTERLEAVED_BLOCKS) {
+        size_t lengthsSize = reader.bitsRead() / 8;
+        if (!decodeInterleavedText(data + lengthsSize, dataSize - lengthsSize,
+                                   lengths, text, textSize)) {
+            error("decodeBlock: Block text is broken");
+        }
+        return;
+    }
+    long long decodedSize = decodeTextToBuffer(reader, lengths, text, textSize);
+    if (decodedSize != (long long) textSize) {
+        error("decodeBlock: Block text is broken");
+    }
+}
+
+void decodeTypedBlock(const char* data, size_t dataSize, char* text, size_t textSize,
+                      BlockCoding coding) {
+    if (dataSize == 0) {
+        error("decodeBlock: Block type is missed");
+    }
+    switch (data[0]) {
+    case STORED_BLOCK:
+        if (dataSize - 1 != textSize) {
+            error("decodeBlock: Stored block size is broken");
+        }
+        copy(data + 1, data + dataSize, text);
+        break;
+    case RUN_BLOCK:
+        if (dataSize != 2) {
+            error("decodeBlock: Run block size is broken");
+        }
+        fill(text, text + textSize, data[1]);
+        break;
+    case CODED_BLOCK:
+        decodeBlock(data + 1, dataSize - 1, text, textSize, coding);
+        break;
+    default:
+        error("decodeBlock: Block type is broken");
+    }
+}
+
+/* Type: ContainerState
+ * Place in the cypher file and index of written blocks.
+ */
+struct ContainerState {
+    long long filePos;
+    BlockCoding coding;
+    std::vector<BlockIndexEntry> index;
+};
+
+/* Function: containerVersion
+ * --------------------------
+ * Returns container version byte of blocks coding.
+ */
+static int containerVersion(BlockCoding coding) {
+    switch (coding) {
+    case INTERLEAVED_BLOCKS:
+        return BLOCKS_INTERLEAVED_VERSION;
+    case RANS_BLOCKS:
+        return BLOCKS_RANS_VERSION;
+    case LZ77_BLOCKS:
+        return BLOCKS_LZ77_VERSION;
+    case CONTEXT_BLOCKS:
+        return BLOCKS_CONTEXT_VERSION;
+    default:
+        return BLOCKS_VERSION;
+    }
+}
+
+/* Function: writeContainerHeader
+ * ------------------------------
+ * Appends magic bytes, version and block size to chunk.
+ */
+static void writeContainerHeader(Chunk& chunk, int blockSize, ContainerState& state) {
+    chunk.insert(chunk.end(), HEADER_MAGIC, HEADER_MAGIC + HEADER_MAGIC_SIZE);
+    chunk.push_back((char) (containerVersion(state.coding) | BLOCKS_TYPED_FLAG));
+    putNumber(chunk, blockSize, 4);
+    state.filePos = CONTAINER_HEADER_SIZE;
+    state.index.clear();
+}
+
+/* Function: writeBlockGroup
+ * -------------------------
+ * Codes group of blocks in parallel into own data vectors,
+ * and then appends them in order with block headers to
+ * chunk, while index entries are collected for the end.
+ */
+static void writeBlockGroup(const unsigned char* text, size_t size, int blockSize,
+                            int maxCodeLength, ThreadPool& pool,
+                            Chunk& chunk, ContainerState& state) {
+    int groupBlocks = (size + blockSize - 1) / blockSize;
+    vector<vector<char> > groupData(groupBlocks);
+    pool.run(groupBlocks, [&](int i) {
+        size_t textOffset = (size_t) i * blockSize;
+        size_t textSize = min((size_t) blockSize, size - textOffset);
+        encodeTypedBlock(text + textOffset, textSize, maxCodeLength, groupData[i], state.coding);
+    });
+
+    long long textPos = 0;
+    if (!state.index.empty()) {
+        textPos = state.index.back().textOffset + state.index.back().textSize;
+    }
+    for (int i = 0; i < groupBlocks; i++) {
+        BlockIndexEntry entry;
+        entry.textOffset = textPos;
+        entry.dataOffset = state.filePos;
+        entry.textSize = (int) min((size_t) blockSize, size - (size_t) i * blockSize);
+        entry.dataSize = groupData[i].size();
+        state.index.push_back(entry);
+
+        putNumber(chunk, entry.textSize, 4);
+        putNumber(chunk, entry.dataSize, 4);
+        chunk.insert(chunk.end(), groupData[i].begin(), groupData[i].end());
+        textPos += entry.textSize;
+        state.filePos += BLOCK_HEADER_SIZE + entry.dataSize;
+    }
+}
+
+/* Function: writeContainerEnd
+ * ---------------------------
+ * Appends end block, index and footer to chunk.
+ */
+static void writeContainerEnd(Chunk& bytes, ContainerState& state) {
+    putNumber(bytes, 0, BLOCK_HEADER_SIZE);
+    long long indexOffset = state.filePos + BLOCK_HEADER_SIZE;
+    for (const BlockIndexEntry& entry : state.index) {
+        putNumber(bytes, entry.textOffset, 8);
+        putNumber(bytes, entry.dataOffset, 8);
+        putNumber(bytes, entry.textSize, 4);
+        putNumber(bytes, entry.dataSize, 4);
+    }
+    putNumber(bytes, indexOffset, 8);
+    putNumber(bytes, state.index.size(), 4);
+    bytes.insert(bytes.end(), INDEX_MAGIC, INDEX_MAGIC + INDEX_MAGIC_SIZE);
+}
+
+/* Function: writeChunk
+ * --------------------
+ * Writes and flushes one chunk. Reports error if out has
+ * failed, so full disk or closed pipe don't lose data
+ * silently.
+ */
+static void writeChunk(const Chunk& chunk, ostream& out) {
+    if (!chunk.empty()) {
+        out.write(&chunk[0], chunk.size());
+    }
+    out.flush();
+    if (out.fail()) {
+        error("Can't write output stream");
+    }
+}
+
+/* Function: writeStoredContainer
+ * ------------------------------
+ * Replaces chunk by stored container of text.
+ */
+static void writeStoredContainer(const unsigned char* text, size_t size, Chunk& chunk) {
+    chunk.clear();
+    chunk.insert(chunk.end(), HEADER_MAGIC, HEADER_MAGIC + HEADER_MAGIC_SIZE);
+    chunk.push_back((char) BLOCKS_STORED_VERSION);
+    putNumber(chunk, size, 4);
+    chunk.insert(chunk.end(), text, text + size);
+}
+
+/* Function: writeChunks
+ * ---------------------
+ * Writer stage: writes chunks in order, while next ones
+ * are coded. Every chunk is flushed, so consumer of the
+ * pipe gets every group at once.
+ */
+static void writeChunks(SpscRing<Chunk>& ring, ostream& out) {
+    Chunk chunk;
+    while (ring.pop(chunk)) {
+        writeChunk(chunk, out);
+    }
+}
+
+/* Function: sendChunk
+ * -------------------
+ * Gives chunk to writer stage and starts new one. If writer
+ * has failed, throws its error.
+ */
+static void sendChunk(SpscRing<Chunk>& ring, PipelineStage<Chunk>& writer, Chunk& chunk) {
+    if (!ring.push(chunk)) {
+        writer.finish();
+    }
+    chunk.clear();
+}
+
+/* Function: compressBlocks
+ * ------------------------
+ * Text is coded by groups of BLOCKS_PER_THREAD blocks for
+ * every thread of pool, and coded groups are written by
+ * writer thread, while the next group is coded. Text of
+ * one group has nothing to overlap, so it's written by
+ * calling thread, and small files don't start threads.
+ * Text of one block is stored, if its container is longer
+ * then stored container.
+ */
+void compressBlocks(const unsigned char* text, size_t size, ostream& out,
+                    int maxCodeLength, ThreadPool& pool, int blockSize, BlockCoding coding) {
+    ContainerState state;
+    state.coding = coding;
+    Chunk chunk;
+    writeContainerHeader(chunk, blockSize, state);
+    size_t groupSize = (size_t) pool.size() * BLOCKS_PER_THREAD * blockSize;
+    if (size <= groupSize) {
+        writeBlockGroup(text, size, blockSize, maxCodeLength, pool, chunk, state);
+        writeContainerEnd(chunk, state);
+        if ((size <= (size_t) blockSize) && (chunk.size() > CONTAINER_HEADER_SIZE + size)) {
+            writeStoredContainer(text, size, chunk);
+        }
+        writeChunk(chunk, out);
+        return;
+    }
+
+    SpscRing<Chunk> coded(PIPELINE_CHUNKS);
+    PipelineStage<Chunk> writer(coded, [&] { writeChunks(coded, out); });
+    for (size_t groupStart = 0; groupStart < size; groupStart += groupSize) {
+        writeBlockGroup(text + groupStart, min(groupSize, size - groupStart),
+                        blockSize, maxCodeLength, pool, chunk, state);
+        sendChunk(coded, writer, chunk);
+    }
+    writeContainerEnd(chunk, state);
+    sendChunk(coded, writer, chunk);
+    coded.close();
+    writer.finish();
+}
+
+/* Function: readFully
+ * -------------------
+ * Reads stream until buffer is full or stream is over,
+ * as pipes give data by small parts. Returns count of
+ * read bytes.
+ */
+static size_t readFully(istream& in, char* buffer, size_t size) {
+    size_t readSize = 0;
+    while (readSize < size) {
+        in.read(buffer + readSize, size - readSize);
+        size_t count = in.gcount();
+        if (count == 0) break;
+        readSize += count;
+    }
+    return readSize;
+}
+
+/* Function: readWindows
+ * ----------------------
+ * Reader stage: reads stream by windows of windowSize bytes,
+ * up to its end.
+ */
+static void readWindows(istream& in, SpscRing<Chunk>& ring, size_t windowSize) {
+    while (true) {
+        Chunk window(windowSize);
+        size_t readSize = readFully(in, &window[0], windowSize);
+        if (readSize == 0) break;
+        window.resize(readSize);
+        if (!ring.push(window)) break;
+    }
+}
+
+/* Function: compressBlocksStream
+ * ------------------------------
+ * The same groups as compressBlocks has, but every group is
+ * read from stream into one window buffer. Reader thread
+ * reads the next window, while this one is coded, and
+ * writer thread writes the previous one. Stream, which
+ * ends in the first window, is the same as text of one
+ * group, so it's written by compressBlocks.
+ */
+void compressBlocksStream(istream& in, ostream& out, int maxCodeLength,
+                          ThreadPool& pool, int blockSize, BlockCoding coding) {
+    ContainerState state;
+    state.coding = coding;
+    size_t windowSize = (size_t) pool.size() * BLOCKS_PER_THREAD * blockSize;
+    SpscRing<Chunk> windows(PIPELINE_CHUNKS);
+    PipelineStage<Chunk> reader(windows, [&] { readWindows(in, windows, windowSize); });
+    Chunk window;
+    if (!windows.pop(window) || (window.size() < windowSize)) {
+        reader.finish();
+        compressBlocks((const unsigned char*) window.data(), window.size(), out,
+                       maxCodeLength, pool, blockSize, coding);
+        return;
+    }
+    SpscRing<Chunk> coded(PIPELINE_CHUNKS);
+    PipelineStage<Chunk> writer(coded, [&] { writeChunks(coded, out); });
+
+    Chunk chunk;
+    writeContainerHeader(chunk, blockSize, state);
+    do {
+        writeBlockGroup((const unsigned char*) &window[0], window.size(),
+                        blockSize, maxCodeLength, pool, chunk, state);
+        sendChunk(coded, writer, chunk);
+    } while (windows.pop(window));
+    reader.finish();
+    writeContainerEnd(chunk, state);
+    sendChunk(coded, writer, chunk);
+    coded.close();
+    writer.finish();
+}
+
+/* Function: isStoredContainer
+ * ----------------------------
+ * Returns true if data starts as stored container.
+ */
+static bool isStoredContainer(const char* data, size_t size) {
+    return (size >= CONTAINER_HEADER_SIZE)
+            && equal(HEADER_MAGIC, HEADER_MAGIC + HEADER_MAGIC_SIZE, data)
+            && ((unsigned char) data[HEADER_MAGIC_SIZE] == BLOCKS_STORED_VERSION);
+}
+
+bool isBlockContainer(const char* data, size_t size) {
+    if (isStoredContainer(data, size)) return true;
+    if (size < CONTAINER_HEADER_SIZE) return false;
+    if (!equal(HEADER_MAGIC, HEADER_MAGIC + HEADER_MAGIC_SIZE, data)) return false;
+    int version = (unsigned char) data[HEADER_MAGIC_SIZE] & ~BLOCKS_TYPED_FLAG;
+    return (version == BLOCKS_VERSION)
+            || (version == BLOCKS_INTERLEAVED_VERSION)
+            || (version == BLOCKS_RANS_VERSION)
+            || (version == BLOCKS_LZ77_VERSION)
+            || (version == BLOCKS_CONTEXT_VERSION);
+}
+
+/* Function: containerCoding
+ * -------------------------
+ * Returns coding of blocks by container version.
+ */
+static BlockCoding containerCoding(const char* containerHeader) {
+    switch ((unsigned char) containerHeader[HEADER_MAGIC_SIZE] & ~BLOCKS_TYPED_FLAG) {
+    case BLOCKS_INTERLEAVED_VERSION:
+        return INTERLEAVED_BLOCKS;
+    case BLOCKS_RANS_VERSION:
+        return RANS_BLOCKS;
+    case BLOCKS_LZ77_VERSION:
+        return LZ77_BLOCKS;
+    case BLOCKS_CONTEXT_VERSION:
+        return CONTEXT_BLOCKS;
+    default:
+        return SINGLE_STREAM_BLOCKS;
+    }
+}
+
+/* Function: decodeContainerBlock
+ * ------------------------------
+ * Decodes block data by coding of container, with or
+ * without type byte.
+ */
+static void decodeContainerBlock(const char* containerHeader, const char* data,
+                                 size_t dataSize, char* text, size_t textSize) {
+    BlockCoding coding = containerCoding(containerHeader);
+    if ((unsigned char) containerHeader[HEADER_MAGIC_SIZE] & BLOCKS_TYPED_FLAG) {
+        decodeTypedBlock(data, dataSize, text, textSize, coding);
+    } else {
+        decodeBlock(data, dataSize, text, textSize, coding);
+    }
+}
+
+/* Function: getContainerBlockSize
+ * ---------------------------------
+ * Returns block size of container header, or 0 if it's out
+ * of range from 1 to MAX_BLOCK_SIZE.
+ */
+static int getContainerBlockSize(const char* containerHeader) {
+    unsigned long long blockSize = getNumber(containerHeader + HEADER_MAGIC_SIZE + 1, 4);
+    return ((blockSize > 0) && (blockSize <= MAX_BLOCK_SIZE)) ? (int) blockSize : 0;
+}
+
+/* Function: getMaxDataSize
+ * ------------------------
+ * Returns the biggest data size of block of textSize bytes.
+ * Typed block is stored, if it isn't shorter coded, so it
+ * has one type byte more then text at most - as compressBound
+ * counts. Blocks of older containers have no stored fallback,
+ * and they get an eighth of text and 4 KB for code tables.
+ */
+static long long getMaxDataSize(const char* containerHeader, long long textSize) {
+    if ((unsigned char) containerHeader[HEADER_MAGIC_SIZE] & BLOCKS_TYPED_FLAG) {
+        return textSize + 1;
+    }
+    return textSize + textSize / 8 + 4096;
+}
+
+/* Function: readBlockIndex
+ * ------------------------
+ * Index is trusted only if footer points right before itself,
+ * and every block lies inside the file and follows previous
+ * one both in the text and in the file. Block text isn't
+ * empty nor bigger then block size of container header,
+ * and its data isn't bigger then coded text could be, so
+ * broken index can't make decoder allocate more.
+ */
+bool readBlockIndex(const char* data, size_t size, vector<BlockIndexEntry>& index) {
+    if (!isBlockContainer(data, size)) return false;
+    index.clear();
+    if (isStoredContainer(data, size)) {
+        size_t textSize = getNumber(data + HEADER_MAGIC_SIZE + 1, 4);
+        if ((textSize > (size_t) MAX_BLOCK_SIZE)
+                || (CONTAINER_HEADER_SIZE + textSize != size)) {
+            return false;
+        }
+        if (textSize > 0) {
+            BlockIndexEntry entry;
+            entry.textOffset = 0;
+            entry.dataOffset = CONTAINER_HEADER_SIZE;
+            entry.textSize = (int) textSize;
+            entry.dataSize = (int) textSize;
+            index.push_back(entry);
+        }
+        return true;
+    }
+    if (size < CONTAINER_HEADER_SIZE + BLOCK_HEADER_SIZE + INDEX_FOOTER_SIZE) return false;
+    const char* footer = data + size - INDEX_FOOTER_SIZE;
+    if (!equal(INDEX_MAGIC, INDEX_MAGIC + INDEX_MAGIC_SIZE, footer + 12)) return false;
+    unsigned long long indexOffset = getNumber(footer, 8);
+    unsigned long long blockCount = getNumber(footer + 8, 4);
+    if (indexOffset > size) return false;
+    if (indexOffset + blockCount * BLOCK_INDEX_ENTRY_SIZE + INDEX_FOOTER_SIZE != size) return false;
+    int blockSize = getContainerBlockSize(data);
+    if (blockSize == 0) return false;
+
+    long long textPos = 0;
+    long long filePos = CONTAINER_HEADER_SIZE;
+    for (unsigned long long i = 0; i < blockCount; i++) {
+        if (filePos + BLOCK_HEADER_SIZE > (long long) indexOffset) return false;
+        const char* cp = data + indexOffset + i * BLOCK_INDEX_ENTRY_SIZE;
+        BlockIndexEntry entry;
+        entry.textOffset = getNumber(cp, 8);
+        entry.dataOffset = getNumber(cp + 8, 8);
+        entry.textSize = (int) getNumber(cp + 16, 4);
+        entry.dataSize = (int) getNumber(cp + 20, 4);
+        if ((entry.textOffset != textPos) || (entry.dataOffset != filePos)) return false;
+        if ((entry.textSize <= 0) || (entry.textSize > blockSize) || (entry.dataSize < 0)
+                || (entry.dataSize > getMaxDataSize(data, entry.textSize))) {
+            return false;
+        }
+        textPos += entry.textSize;
+        filePos += BLOCK_HEADER_SIZE + (long long) entry.dataSize;
+        index.push_back(entry);
+    }
+    /* End block is right before index */
+    return filePos + BLOCK_HEADER_SIZE == (long long) indexOffset;
+}
+
+/* Function: decodeIndexedBlock
+ * ------------------------------
+ * Decodes block of index entry, after block header is
+ * checked to be the same as entry. Text of stored
+ * container is copied.
+ */
+static void decodeIndexedBlock(const char* data, const BlockIndexEntry& entry, char* text) {
+    if ((unsigned char) data[HEADER_MAGIC_SIZE] == BLOCKS_STORED_VERSION) {
+        copy(data + entry.dataOffset, data + entry.dataOffset + entry.textSize, text);
+        return;
+    }
+    const char* header = data + entry.dataOffset;
+    if (((long long) getNumber(header, 4) != entry.textSize)
+            || ((long long) getNumber(header + 4, 4) != entry.dataSize)) {
+        error("decodeBlock: Block header doesn't match block index");
+    }
+    decodeContainerBlock(data, header + BLOCK_HEADER_SIZE, entry.dataSize,
+                         text, entry.textSize);
+}
+
+/* Function: decompressBlocks
+ * --------------------------
+ * Group of blocks is decoded into one text buffer, which
+ * is written at once by writer thread, while the next
+ * group is decoded. Single group is written by calling
+ * thread, as compressBlocks does.
+ */
+void decompressBlocks(const char* data, size_t size, ostream& out, ThreadPool& pool) {
+    vector<BlockIndexEntry> index;
+    if (!readBlockIndex(data, size, index)) {
+        error("decompressBlocks: Block index is broken");
+    }
+
+    int blockCount = index.size();
+    int groupSize = pool.size() * BLOCKS_PER_THREAD;
+    Chunk groupText;
+    if (blockCount <= groupSize) {
+        if (blockCount == 0) return;
+        groupText.resize(index.back().textOffset + index.back().textSize);
+        if (groupText.empty()) return;
+        pool.run(blockCount, [&](int i) {
+            decodeIndexedBlock(data, index[i], &groupText[index[i].textOffset]);
+        });
+        writeChunk(groupText, out);
+        return;
+    }
+
+    SpscRing<Chunk> decoded(PIPELINE_CHUNKS);
+    PipelineStage<Chunk> writer(decoded, [&] { writeChunks(decoded, out); });
+    for (int groupStart = 0; groupStart < blockCount; groupStart += groupSize) {
+        int groupEnd = min(groupStart + groupSize, blockCount);
+        long long groupOffset = index[groupStart].textOffset;
+        const BlockIndexEntry& last = index[groupEnd - 1];
+        groupText.resize(last.textOffset + last.textSize - groupOffset);
+        if (groupText.empty()) continue;
+
+        pool.run(groupEnd - groupStart, [&](int i) {
+            const BlockIndexEntry& entry = index[groupStart + i];
+            decodeIndexedBlock(data, entry, &groupText[entry.textOffset - groupOffset]);
+        });
+        sendChunk(decoded, writer, groupText);
+    }
+    decoded.close();
+    writer.finish();
+}
+
+/* Function: decompressBlocksRange
+ * -------------------------------
+ * Finds the first block of range by binary search in index,
+ * and decodes only blocks, which have bytes of the range.
+ */
+long long decompressBlocksRange(const char* data, size_t size,
+                                long long offset, long long length, ostream& out) {
+    vector<BlockIndexEntry> index;
+    if (!readBlockIndex(data, size, index)) {
+        error("decompressBlocksRange: Block index is broken");
+    }
+    if ((offset < 0) || (length <= 0) || index.empty()) return 0;
+    const BlockIndexEntry& lastBlock = index.back();
+    long long textEnd = lastBlock.textOffset + lastBlock.textSize;
+    if (offset >= textEnd) return 0;
+    long long rangeEnd = (length < textEnd - offset) ? offset + length : textEnd;
+
+    /* The first block, which ends after offset */
+    int first = 0;
+    int last = index.size() - 1;
+    while (first < last) {
+        int middle = (first + last) / 2;
+        if (index[middle].textOffset + index[middle].textSize <= offset) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    vector<char> blockText;
+    for (int i = first; (i < (int) index.size()) && (index[i].textOffset < rangeEnd); i++) {
+        const BlockIndexEntry& entry = index[i];
+        blockText.resize(entry.textSize);
+        decodeIndexedBlock(data, entry, &blockText[0]);
+        long long from = max(offset, entry.textOffset) - entry.textOffset;
+        long long to = min(rangeEnd, entry.textOffset + entry.textSize) - entry.textOffset;
+        out.write(&blockText[from], to - from);
+    }
+    return rangeEnd - offset;
+}
+
+/* Function: readBlockHeader
+ * -------------------------
+ * Reads block header from stream. Returns false if stream
+ * is over before the end block.
+ */
+static bool readBlockHeader(istream& in, int& textSize, int& dataSize) {
+    char header[BLOCK_HEADER_SIZE];
+    if (readFully(in, header, BLOCK_HEADER_SIZE) != BLOCK_HEADER_SIZE) return false;
+    textSize = (int) getNumber(header, 4);
+    dataSize = (int) getNumber(header + 4, 4);
+    return (textSize >= 0) && (dataSize >= 0);
+}
+
+/* Function: copyStoredText
+ * -------------------------
+ * Reads text of stored container from stream, and writes
+ * it into out.
+ */
+static void copyStoredText(const char* containerHeader, istream& in, ostream& out) {
+    size_t textSize = getNumber(containerHeader + HEADER_MAGIC_SIZE + 1, 4);
+    if (textSize > (size_t) MAX_BLOCK_SIZE) {
+        error("decompressBlocksStream: Block size of container is broken");
+    }
+    Chunk text(textSize);
+    if (readFully(in, text.data(), textSize) != textSize) {
+        error("decompressBlocksStream: Stream is broken");
+    }
+    writeChunk(text, out);
+}
+
+/* Type: BlockGroup
+ * Data of group of blocks, which is read from stream.
+ */
+struct BlockGroup {
+    vector<Chunk> data;
+    vector<int> textSizes;
+    size_t textSize;
+};
+
+/* Function: readBlockGroups
+ * -------------------------
+ * Reader stage: reads groups of groupSize blocks up to the
+ * end block, and then the rest of stream. Block header is
+ * checked before its data is allocated, so broken stream
+ * can't take more memory then group of whole blocks.
+ */
+static void readBlockGroups(istream& in, SpscRing<BlockGroup>& ring,
+                            const char* containerHeader, int blockSize, int groupSize) {
+    bool streamEnd = false;
+    while (!streamEnd) {
+        BlockGroup group;
+        group.textSize = 0;
+        while ((int) group.data.size() < groupSize) {
+            int textSize = 0;
+            int dataSize = 0;
+            if (!readBlockHeader(in, textSize, dataSize)) {
+                error("decompressBlocksStream: Stream is broken");
+            }
+            if ((textSize == 0) && (dataSize == 0)) {
+                streamEnd = true;
+                break;
+            }
+            if ((textSize == 0) || (textSize > blockSize) || (dataSize == 0)
+                    || (dataSize > getMaxDataSize(containerHeader, textSize))) {
+                error("decompressBlocksStream: Block header is broken");
+            }
+            group.data.push_back(Chunk(dataSize));
+            if (readFully(in, &group.data.back()[0], dataSize) != (size_t) dataSize) {
+                error("decompressBlocksStream: Stream is broken");
+            }
+            group.textSizes.push_back(textSize);
+            group.textSize += textSize;
+        }
+        if (group.data.empty()) break;
+        if (!ring.push(group)) return;
+    }
+
+    /* Block index isn't needed, but pipe has to be read up to the end */
+    in.ignore(numeric_limits<streamsize>::max());
+}
+
+/* Function: decompressBlocksStream
+ * --------------------------------
+ * Reads block headers one by one, so index isn't needed.
+ * Reader thread reads the next group of blocks, while this
+ * one is decoded in parallel, and writer thread writes the
+ * previous one. Text of stored container is copied.
+ */
+void decompressBlocksStream(istream& in, ostream& out, ThreadPool& pool) {
+    char header[CONTAINER_HEADER_SIZE];
+    if ((readFully(in, header, CONTAINER_HEADER_SIZE) != CONTAINER_HEADER_SIZE)
+            || !isBlockContainer(header, CONTAINER_HEADER_SIZE)) {
+        error("decompressBlocksStream: Stream is not block container");
+    }
+    if (isStoredContainer(header, CONTAINER_HEADER_SIZE)) {
+        copyStoredText(header, in, out);
+        return;
+    }
+    int blockSize = getContainerBlockSize(header);
+    if (blockSize == 0) {
+        error("decompressBlocksStream: Block size of container is broken");
+    }
+    int groupSize = pool.size() * BLOCKS_PER_THREAD;
+
+    SpscRing<BlockGroup> groups(PIPELINE_CHUNKS);
+    PipelineStage<BlockGroup> reader(groups, [&] {
+        readBlockGroups(in, groups, header, blockSize, groupSize);
+    });
+    SpscRing<Chunk> decoded(PIPELINE_CHUNKS);
+    PipelineStage<Chunk> writer(decoded, [&] { writeChunks(decoded, out); });
+
+    BlockGroup group;
+    while (groups.pop(group)) {
+        int groupBlocks = group.data.size();
+        Chunk groupText(group.textSize);
+        vector<size_t> textOffsets(groupBlocks, 0);
+        for (int i = 1; i < groupBlocks; i++) {
+            textOffsets[i] = textOffsets[i - 1] + group.textSizes[i - 1];
+        }
+        pool.run(groupBlocks, [&](int i) {
+            decodeContainerBlock(header, &group.data[i][0], group.data[i].size(),
+                                 &groupText[textOffsets[i]], group.textSizes[i]);
+        });
+        sendChunk(decoded, writer, groupText);
+    }
+    reader.finish();
+    decoded.close();
+    writer.finish();
+}
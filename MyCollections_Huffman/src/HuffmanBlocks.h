@@ -0,0 +1,269 @@
+/*******************************************************
+* File: HuffmanBlocks.h
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - decompressBlocksRange() for random access
+*
+* v.3 2026/10/18
+* - compressBlocksStream(), decompressBlocksStream()
+*
+* v.4 2026/10/18
+* - interleaved blocks of INTERLEAVED_STREAMS streams
+*
+* v.5 2026/10/18
+* - BlockCoding of container, rANS blocks
+*
+* v.6 2026/10/18
+* - LZ77 blocks
+*
+* v.7 2026/10/18
+* - order-1 context blocks
+*
+* v.8 2026/10/18
+* - typed blocks: stored, run or coded
+*
+* v.9 2026/10/18
+* - reader and writer threads of pipeline around coding
+*
+* v.10 2026/10/18
+* - MAX_BLOCK_SIZE of decoded containers
+*
+* v.11 2026/10/18
+* - stored container of small texts, which don't get shorter
+*
+* Block container of Huffman cypher files. Text is split
+* into independent blocks, which are coded and decoded
+* by all threads of ThreadPool at the same time.
+*
+* Container format, all numbers are little-endian:
+* - HEADER_MAGIC bytes, BLOCKS_VERSION, BLOCKS_INTERLEAVED_VERSION,
+*   BLOCKS_RANS_VERSION, BLOCKS_LZ77_VERSION or
+*   BLOCKS_CONTEXT_VERSION byte, BLOCKS_TYPED_FLAG is added
+*   to the version of containers with typed blocks;
+* - 4 bytes - block size of the text;
+* - blocks, every one is:
+*     4 bytes - count of text bytes in block,
+*     4 bytes - count of block data bytes,
+*     in typed container - BlockType byte, and then
+*     stored text, or run byte, or coded block data;
+*     block data - code lengths (see encodeCodeLengths),
+*     block text codes and PSEUDO_EOF code, padded to byte,
+*     or in interleaved container - jump table and streams
+*     of text parts (see encodeInterleavedText), or in rANS
+*     container - frequencies and rANS stream (see HuffmanRans.h),
+*     or in LZ77 container - code lengths and codes of literals
+*     and matches (see HuffmanLz77.h), or in context container -
+*     context clusters, their code lengths and codes
+*     (see HuffmanContext.h);
+* - end block - 8 zero bytes;
+* - block index, BLOCK_INDEX_ENTRY_SIZE bytes for every block:
+*     8 bytes - offset of block text in the whole text,
+*     8 bytes - offset of block in the cypher file,
+*     4 bytes - count of text bytes in block,
+*     4 bytes - count of block data bytes;
+* - index footer:
+*     8 bytes - offset of block index in the cypher file,
+*     4 bytes - count of blocks,
+*     INDEX_MAGIC bytes.
+*
+* Text of one block, whose container would be longer then
+* the text itself, is written as stored container instead:
+* HEADER_MAGIC bytes, BLOCKS_STORED_VERSION byte, 4 bytes -
+* size of the text, and the text as it is. So small files
+* grow by CONTAINER_HEADER_SIZE bytes at most.
+*******************************************************/
+
+#ifndef HuffmanBlocks_Included
+#define HuffmanBlocks_Included
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "threadpool.h"
+
+/* Constant: BLOCK_SIZE
+ * Default count of text bytes in every block but last.
+ */
+const int BLOCK_SIZE = 1 << 20;
+
+/* Constant: MAX_BLOCK_SIZE
+ * The biggest block size of container, which is decoded.
+ * Decoder keeps few blocks for every thread in memory, so
+ * broken header can't make it allocate more.
+ */
+const int MAX_BLOCK_SIZE = 1 << 26;
+
+/* Constants: CONTAINER_HEADER_SIZE, BLOCK_HEADER_SIZE, ...
+ * Sizes of fixed parts of container.
+ */
+const int CONTAINER_HEADER_SIZE = 8;
+const int BLOCK_HEADER_SIZE = 8;
+const int BLOCK_INDEX_ENTRY_SIZE = 24;
+const int INDEX_FOOTER_SIZE = 16;
+
+/* Constant: INDEX_MAGIC
+ * Last bytes of container, which end the index footer.
+ */
+const char INDEX_MAGIC[] = "HIDX";
+const int INDEX_MAGIC_SIZE = 4;
+
+/* Type: BlockCoding
+ * Coding of all blocks of container, which is kept by its
+ * version byte.
+ */
+enum BlockCoding {
+    SINGLE_STREAM_BLOCKS,
+    INTERLEAVED_BLOCKS,
+    RANS_BLOCKS,
+    LZ77_BLOCKS,
+    CONTEXT_BLOCKS
+};
+
+/* Type: BlockType
+ * Kind of block of container with BLOCKS_TYPED_FLAG, which
+ * is kept in the first byte of block data:
+ * - STORED_BLOCK - text bytes as they are;
+ * - RUN_BLOCK - one byte, which repeats through the whole text;
+ * - CODED_BLOCK - block data of container coding.
+ */
+enum BlockType {
+    STORED_BLOCK,
+    RUN_BLOCK,
+    CODED_BLOCK
+};
+
+/* Constant: CODED_BLOCK_MAX_RATIO
+ * Block is coded, only if estimate of its coded size is less
+ * then this part of text size. Otherwise it's stored without
+ * coding at all.
+ */
+const double CODED_BLOCK_MAX_RATIO = 0.97;
+
+/* Type: BlockIndexEntry
+ * Place of one block in the text and in cypher file.
+ * dataOffset points to block header.
+ */
+struct BlockIndexEntry {
+    long long textOffset;
+    long long dataOffset;
+    int textSize;
+    int dataSize;
+};
+
+/* Function: encodeBlock
+ * Usage: encodeBlock(text, size, maxCodeLength, data, coding);
+ * ------------------------------------------------------------
+ * Codes text block by its own canonical codes or rANS
+ * frequencies, and appends block data to data vector.
+ * Block header isn't written.
+ */
+void encodeBlock(const unsigned char* text, size_t size,
+                 int maxCodeLength, std::vector<char>& data, BlockCoding coding);
+
+/* Function: encodeTypedBlock
+ * Usage: encodeTypedBlock(text, size, maxCodeLength, data, coding);
+ * -----------------------------------------------------------------
+ * Appends type byte and block data to data vector. Text of
+ * one byte value is run block. Text, which has no gain by
+ * entropy estimate of its histogram, is stored without coding.
+ * Estimate is not used by LZ77 and context codings, which
+ * could win more then histogram shows, but they are stored
+ * too, if coded data isn't shorter then text.
+ */
+void encodeTypedBlock(const unsigned char* text, size_t size,
+                      int maxCodeLength, std::vector<char>& data, BlockCoding coding);
+
+/* Function: decodeBlock
+ * Usage: decodeBlock(data, dataSize, text, textSize, coding);
+ * -----------------------------------------------------------
+ * Decodes block data into text buffer. Reports error if
+ * data is broken, or decoded text isn't textSize long.
+ */
+void decodeBlock(const char* data, size_t dataSize, char* text, size_t textSize,
+                 BlockCoding coding);
+
+/* Function: decodeTypedBlock
+ * Usage: decodeTypedBlock(data, dataSize, text, textSize, coding);
+ * ----------------------------------------------------------------
+ * Decodes block data, which starts from type byte, into text
+ * buffer. Reports error if data is broken.
+ */
+void decodeTypedBlock(const char* data, size_t dataSize, char* text, size_t textSize,
+                      BlockCoding coding);
+
+/* Function: compressBlocks
+ * Usage: compressBlocks(text, size, out, maxCodeLength, pool);
+ * ------------------------------------------------------------
+ * Writes block container of the whole text into out.
+ * Blocks are coded by pool threads, by groups of few
+ * blocks per thread, and are written in text order.
+ * Interleaved blocks are decoded faster by one thread.
+ */
+void compressBlocks(const unsigned char* text, size_t size, std::ostream& out,
+                    int maxCodeLength, ThreadPool& pool, int blockSize = BLOCK_SIZE,
+                    BlockCoding coding = INTERLEAVED_BLOCKS);
+
+/* Function: compressBlocksStream
+ * Usage: compressBlocksStream(cin, cout, maxCodeLength, pool);
+ * ------------------------------------------------------------
+ * Writes block container of the whole in stream into out,
+ * while in is read by windows of group of blocks. So memory
+ * doesn't depend on text size, and in could be a pipe.
+ * Every group is flushed into out, as soon as it's coded.
+ * Reading, coding and writing of neighbour groups run in
+ * own threads at the same time.
+ */
+void compressBlocksStream(std::istream& in, std::ostream& out, int maxCodeLength,
+                          ThreadPool& pool, int blockSize = BLOCK_SIZE,
+                          BlockCoding coding = INTERLEAVED_BLOCKS);
+
+/* Function: isBlockContainer
+ * Usage: if (isBlockContainer(data, size)) ...
+ * --------------------------------------------
+ * Returns true if cypher file starts as block container
+ * of any version, stored container too.
+ */
+bool isBlockContainer(const char* data, size_t size);
+
+/* Function: readBlockIndex
+ * Usage: if (readBlockIndex(data, size, index)) ...
+ * -------------------------------------------------
+ * Reads block index of container from its footer. Returns
+ * false if index is broken, or has empty block or block
+ * bigger then block size of container header. Index of
+ * stored container has one entry of its whole text, whose
+ * dataOffset points to the text, as it has no block header.
+ */
+bool readBlockIndex(const char* data, size_t size, std::vector<BlockIndexEntry>& index);
+
+/* Function: decompressBlocks
+ * Usage: decompressBlocks(data, size, out, pool);
+ * -----------------------------------------------
+ * Decodes whole block container into out. Blocks are
+ * decoded by pool threads and are written in text order.
+ */
+void decompressBlocks(const char* data, size_t size, std::ostream& out, ThreadPool& pool);
+
+/* Function: decompressBlocksRange
+ * Usage: decompressBlocksRange(data, size, offset, length, out);
+ * --------------------------------------------------------------
+ * Decodes length bytes of text from offset into out. Only
+ * blocks, which have these bytes, are decoded. Range is cut
+ * by the end of text. Returns count of written bytes.
+ */
+long long decompressBlocksRange(const char* data, size_t size,
+                                long long offset, long long length, std::ostream& out);
+
+/* Function: decompressBlocksStream
+ * Usage: decompressBlocksStream(cin, cout, pool);
+ * -----------------------------------------------
+ * Decodes block container from in stream into out. Blocks are
+ * found by their headers up to the end block, so index isn't
+ * used, and memory is bounded by one group of blocks.
+ */
+void decompressBlocksStream(std::istream& in, std::ostream& out, ThreadPool& pool);
+
+#endif
@@ -0,0 +1,134 @@
+/**********************************************************
+* File: HuffmanBuffer.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - MemoryBuffer is moved to mappedfile.h
+*
+* v.3 2026/10/18
+* - single stream data isn't decoded
+*
+* Implementation of the functions from HuffmanBuffer.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include "error.h"
+#include "HuffmanBuffer.h"
+#include "HuffmanEncoding.h"
+#include "HuffmanDecoding.h"
+#include "HuffmanAdaptive.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+
+using namespace std;
+
+/*
+ * Class: SinkBuffer
+ * -----------------
+ * Stream buffer without buffer: every stream write goes
+ * right to the sink, so coders, which write into ostream,
+ * write into sink. Written bytes are counted.
+ */
+class SinkBuffer : public streambuf {
+public:
+    SinkBuffer(OutputSink& sink) : sink(sink), written(0) {
+    }
+
+    size_t size() const {
+        return written;
+    }
+
+protected:
+    streamsize xsputn(const char* bytes, streamsize count) {
+        sink.write(bytes, count);
+        written += count;
+        return count;
+    }
+
+    int_type overflow(int_type c) {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            char byte = traits_type::to_char_type(c);
+            xsputn(&byte, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+private:
+    OutputSink& sink;
+    size_t written;
+};
+
+MemorySink::MemorySink(uint8_t* buffer, size_t capacity)
+    : buffer(buffer), capacity(capacity), written(0) {
+}
+
+void MemorySink::write(const char* bytes, size_t size) {
+    if (size > capacity - written) {
+        error("MemorySink: Output doesn't fit into buffer");
+    }
+    memcpy(buffer + written, bytes, size);
+    written += size;
+}
+
+/* Function: compressBound
+ * -----------------------
+ * Stored block is one byte longer then its text, and coded
+ * one is never longer.
+ */
+size_t compressBound(size_t size) {
+    size_t blockCount = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    return CONTAINER_HEADER_SIZE + size
+            + blockCount * (BLOCK_HEADER_SIZE + 1 + BLOCK_INDEX_ENTRY_SIZE)
+            + BLOCK_HEADER_SIZE + INDEX_FOOTER_SIZE;
+}
+
+/* Function: compressBuffer
+ * ------------------------
+ * Stream errors are exceptions, so sink errors are reported
+ * to caller as they are.
+ */
+size_t compressBuffer(const uint8_t* data, size_t size, OutputSink& sink,
+                      int maxCodeLength, int threadCount, BlockCoding coding) {
+    checkCodeLengthLimit("compressBuffer", maxCodeLength);
+    SinkBuffer buffer(sink);
+    ostream out(&buffer);
+    out.exceptions(ios::badbit);
+    ThreadPool pool(threadCount);
+    compressBlocks(data, size, out, maxCodeLength, pool, BLOCK_SIZE, coding);
+    return buffer.size();
+}
+
+long long decompressedSize(const uint8_t* data, size_t size) {
+    const char* bytes = (const char*) data;
+    if (!isBlockContainer(bytes, size)) return -1;
+    vector<BlockIndexEntry> index;
+    if (!readBlockIndex(bytes, size, index)) {
+        error("decompressedSize: Block index is broken");
+    }
+    if (index.empty()) return 0;
+    return index.back().textOffset + index.back().textSize;
+}
+
+size_t decompressBuffer(const uint8_t* data, size_t size, OutputSink& sink, int threadCount) {
+    const char* bytes = (const char*) data;
+    SinkBuffer buffer(sink);
+    ostream out(&buffer);
+    out.exceptions(ios::badbit);
+
+    if (isBlockContainer(bytes, size)) {
+        ThreadPool pool(threadCount);
+        decompressBlocks(bytes, size, out, pool);
+    } else if (isAdaptiveStream(bytes, size)) {
+        MemoryBuffer input(data, size);
+        istream in(&input);
+        decompressAdaptiveStream(in, out);
+    } else {
+        error("decompressBuffer: Data is not a Huffman cypher");
+    }
+    return buffer.size();
+}
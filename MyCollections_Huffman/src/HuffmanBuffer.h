@@ -0,0 +1,137 @@
+/*******************************************************
+* File: HuffmanBuffer.h
+* --------------------------
+* v.1 2026/10/18
+*
+* In-memory compression API. Caller memory is coded
+* directly, without files and without copying into string
+* streams, and result goes to OutputSink - for example
+* right into caller buffer, which is preallocated by size
+* query functions.
+*******************************************************/
+
+#ifndef HuffmanBuffer_Included
+#define HuffmanBuffer_Included
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "HuffmanCodes.h"
+#include "HuffmanBlocks.h"
+
+/*
+ * Class: OutputSink
+ * -----------------
+ * Receiver of output bytes. Bytes of every write call
+ * follow bytes of the previous one.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink() {}
+
+    /*
+     * Method: write
+     * Usage: sink.write(bytes, size);
+     * -------------------------------
+     * Takes size next output bytes. Reports error if they
+     * can't be taken.
+     */
+    virtual void write(const char* bytes, size_t size) = 0;
+};
+
+/*
+ * Class: MemorySink
+ * -----------------
+ * Writes output into caller buffer of fixed capacity.
+ */
+class MemorySink : public OutputSink {
+public:
+    /*
+     * Constructor: MemorySink
+     * Usage: MemorySink sink(buffer, capacity);
+     * -----------------------------------------
+     * Buffer has to live while sink is used.
+     */
+    MemorySink(uint8_t* buffer, size_t capacity);
+
+    /*
+     * Method: write
+     * -------------
+     * Reports error if output doesn't fit into capacity.
+     */
+    void write(const char* bytes, size_t size);
+
+    /*
+     * Method: size
+     * ------------
+     * Returns count of written bytes.
+     */
+    size_t size() const {
+        return written;
+    }
+
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t written;
+};
+
+/*
+ * Class: VectorSink
+ * -----------------
+ * Appends output to caller vector.
+ */
+class VectorSink : public OutputSink {
+public:
+    VectorSink(std::vector<char>& bytes) : bytes(bytes) {
+    }
+
+    void write(const char* data, size_t size) {
+        bytes.insert(bytes.end(), data, data + size);
+    }
+
+private:
+    std::vector<char>& bytes;
+};
+
+/* Function: compressBound
+ * Usage: size_t capacity = compressBound(size);
+ * ---------------------------------------------
+ * Returns the biggest size of compressBuffer result for
+ * size bytes of text: every block could be stored, and
+ * container adds its headers and index.
+ */
+size_t compressBound(size_t size);
+
+/* Function: compressBuffer
+ * Usage: compressBuffer(data, size, sink);
+ *        compressBuffer(data, size, sink, maxCodeLength, threadCount, coding);
+ * -------------------------------------------------------------------------
+ * Writes block container of size bytes of data into sink,
+ * the same one as compress() writes into file. Returns
+ * count of written bytes.
+ */
+size_t compressBuffer(const uint8_t* data, size_t size, OutputSink& sink,
+                      int maxCodeLength = MAX_CODE_LENGTH, int threadCount = 0,
+                      BlockCoding coding = INTERLEAVED_BLOCKS);
+
+/* Function: decompressedSize
+ * Usage: long long size = decompressedSize(data, size);
+ * -----------------------------------------------------
+ * Returns text size of block container by its index, without
+ * decoding. Returns -1 for other formats, which don't keep
+ * text size.
+ */
+long long decompressedSize(const uint8_t* data, size_t size);
+
+/* Function: decompressBuffer
+ * Usage: decompressBuffer(data, size, sink);
+ *        decompressBuffer(data, size, sink, threadCount);
+ * ---------------------------------------------------
+ * Decodes cypher data of any format, which decompress()
+ * reads, into sink. Returns count of written bytes.
+ */
+size_t decompressBuffer(const uint8_t* data, size_t size, OutputSink& sink,
+                        int threadCount = 0);
+
+#endif
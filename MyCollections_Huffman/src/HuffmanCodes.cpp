@@ -0,0 +1,333 @@
+/**********************************************************
+* File: HuffmanCodes.cpp
+* --------------------------
+* v.2 2026/10/18
+* - canonical codes from code lengths
+* - code lengths limiting
+*
+* v.3 2026/10/18
+* - tree depths without recursion
+*
+* v.4 2026/10/18
+* - linear time code lengths from sorted weights
+*
+* v.5 2026/10/18
+* - alphabet size is taken from lengths
+*
+* v.6 2026/10/18
+* - getTreeCodeLengths() is removed
+*
+* Implementation of the tables from HuffmanCodes.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include "HuffmanCodes.h"
+
+using namespace std;
+
+/* Type: WeightedSymbol
+ * Symbol with its weight, which is sorted by weights.
+ */
+struct WeightedSymbol {
+    unsigned long long weight;
+    int symbol;
+};
+
+/* Function: sortByWeights
+ * -----------------------
+ * LSD radix sort: one counting sort by every byte of weights,
+ * from the lowest one up to the highest not zero byte of the
+ * biggest weight. Counting sort is stable, so symbols of
+ * equal weights keep their order.
+ */
+static void sortByWeights(WeightedSymbol* items, int count) {
+    unsigned long long maxWeight = 0;
+    for (int i = 0; i < count; i++) {
+        maxWeight = max(maxWeight, items[i].weight);
+    }
+    WeightedSymbol buffer[MAX_ALPHABET_SIZE];
+    WeightedSymbol* from = items;
+    WeightedSymbol* to = buffer;
+    for (int shift = 0; (shift < 64) && ((maxWeight >> shift) != 0); shift += 8) {
+        int starts[257] = {0};
+        for (int i = 0; i < count; i++) {
+            starts[((from[i].weight >> shift) & 0xFF) + 1]++;
+        }
+        for (int digit = 0; digit < 256; digit++) {
+            starts[digit + 1] += starts[digit];
+        }
+        for (int i = 0; i < count; i++) {
+            to[starts[(from[i].weight >> shift) & 0xFF]++] = from[i];
+        }
+        swap(from, to);
+    }
+    if (from != items) {
+        copy(from, from + count, items);
+    }
+}
+
+/* Function: minimumRedundancyLengths
+ * ----------------------------------
+ * In place algorithm of Moffat and Katajainen for weights
+ * sorted by increasing. Two queues - of leaves and of made
+ * parents - are both kept in the same array:
+ * - first pass merges two smallest items of queues, and puts
+ *   parent weight to next place, and parent index to places
+ *   of merged parents;
+ * - second pass turns parent indexes into internal depths;
+ * - third pass gives leaves depths of free tree levels.
+ * At the end A[i] is code length of i-th weight.
+ */
+static void minimumRedundancyLengths(unsigned long long* A, int n) {
+    if (n == 0) return;
+    if (n == 1) {
+        A[0] = 1;
+        return;
+    }
+
+    /* First pass, left to right, setting parent pointers */
+    A[0] += A[1];
+    int root = 0;
+    int leaf = 2;
+    for (int next = 1; next < n - 1; next++) {
+        /* First item of pair */
+        if ((leaf >= n) || (A[root] < A[leaf])) {
+            A[next] = A[root];
+            A[root++] = next;
+        } else {
+            A[next] = A[leaf++];
+        }
+        /* Second item of pair */
+        if ((leaf >= n) || ((root < next) && (A[root] < A[leaf]))) {
+            A[next] += A[root];
+            A[root++] = next;
+        } else {
+            A[next] += A[leaf++];
+        }
+    }
+
+    /* Second pass, right to left, setting internal depths */
+    A[n - 2] = 0;
+    for (int next = n - 3; next >= 0; next--) {
+        A[next] = A[A[next]] + 1;
+    }
+
+    /* Third pass, right to left, setting leaf depths */
+    int available = 1;
+    int used = 0;
+    unsigned long long depth = 0;
+    root = n - 2;
+    int next = n - 1;
+    while (available > 0) {
+        while ((root >= 0) && (A[root] == depth)) {
+            used++;
+            root--;
+        }
+        while (available > used) {
+            A[next--] = depth;
+            available--;
+        }
+        available = 2 * used;
+        depth++;
+        used = 0;
+    }
+}
+
+/* Function: getWeightsCodeLengths
+ * -------------------------------
+ * Present symbols are sorted by weights, and their weights
+ * are replaced by code lengths.
+ */
+CodeLengths getWeightsCodeLengths(const long long* weights, int symbolCount) {
+    WeightedSymbol items[MAX_ALPHABET_SIZE];
+    int count = 0;
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        if (weights[symbol] > 0) {
+            items[count].weight = weights[symbol];
+            items[count].symbol = symbol;
+            count++;
+        }
+    }
+    sortByWeights(items, count);
+
+    unsigned long long lengthsPlace[MAX_ALPHABET_SIZE];
+    for (int i = 0; i < count; i++) {
+        lengthsPlace[i] = items[i].weight;
+    }
+    minimumRedundancyLengths(lengthsPlace, count);
+
+    CodeLengths lengths(symbolCount, 0);
+    for (int i = 0; i < count; i++) {
+        lengths[items[i].symbol] = (int) lengthsPlace[i];
+    }
+    return lengths;
+}
+
+/* Function: limitCodeLengths
+ * --------------------------
+ * Works with counts of codes of every length:
+ * - all too long codes are moved to maxCodeLength;
+ * - while Kraft sum is bigger then 1, one code of maxCodeLength
+ *   is removed, and one shorter code is replaced by two codes
+ *   which are one bit longer;
+ * - new lengths are given to symbols ordered by old lengths.
+ */
+void limitCodeLengths(CodeLengths& lengths, int maxCodeLength) {
+    int oldMaxLength = 0;
+    for (int length : lengths) {
+        oldMaxLength = max(oldMaxLength, length);
+    }
+    if (oldMaxLength <= maxCodeLength) {
+        return;
+    }
+
+    vector<int> lengthCounts(oldMaxLength + 1, 0);
+    for (int length : lengths) {
+        if (length > 0) {
+            lengthCounts[min(length, maxCodeLength)]++;
+        }
+    }
+
+    /* Kraft sum in units of the longest code */
+    unsigned long long total = 0;
+    for (int length = 1; length <= maxCodeLength; length++) {
+        total += (unsigned long long) lengthCounts[length] << (maxCodeLength - length);
+    }
+    while (total > (1ULL << maxCodeLength)) {
+        lengthCounts[maxCodeLength]--;
+        for (int length = maxCodeLength - 1; length > 0; length--) {
+            if (lengthCounts[length] != 0) {
+                lengthCounts[length]--;
+                lengthCounts[length + 1] += 2;
+                break;
+            }
+        }
+        total--;
+    }
+
+    /* Symbols ordered by old lengths, then by value */
+    vector<int> symbols;
+    for (int symbol = 0; symbol < (int) lengths.size(); symbol++) {
+        if (lengths[symbol] > 0) {
+            symbols.push_back(symbol);
+        }
+    }
+    stable_sort(symbols.begin(), symbols.end(), [&lengths](int a, int b) {
+        return lengths[a] < lengths[b];
+    });
+    int length = 1;
+    for (int symbol : symbols) {
+        while (lengthCounts[length] == 0) {
+            length++;
+        }
+        lengths[symbol] = length;
+        lengthCounts[length]--;
+    }
+}
+
+/* Function: reverseBits
+ * ---------------------
+ * Canonical codes are numbers, where the first stream bit
+ * is the highest one. Stream bits go from the lowest bit,
+ * so codes are reversed.
+ */
+static unsigned reverseBits(unsigned code, int length) {
+    unsigned result = 0;
+    for (int i = 0; i < length; i++) {
+        result = (result << 1) | (code & 1);
+        code >>= 1;
+    }
+    return result;
+}
+
+/* Function: assignCanonicalCodes
+ * ------------------------------
+ * Codes of each length are consecutive numbers in symbols
+ * order, and the first code of next length follows the
+ * last code of previous one. So lengths define codes fully.
+ */
+static void assignCanonicalCodes(const CodeLengths& lengths, SymbolCode* codes) {
+    int symbolCount = lengths.size();
+    int lengthCounts[MAX_CODE_LENGTH + 1] = {0};
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        lengthCounts[lengths[symbol]]++;
+    }
+    lengthCounts[0] = 0;
+
+    unsigned nextCode[MAX_CODE_LENGTH + 1];
+    unsigned code = 0;
+    for (int length = 1; length <= MAX_CODE_LENGTH; length++) {
+        code = (code + lengthCounts[length - 1]) << 1;
+        nextCode[length] = code;
+    }
+
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        int length = lengths[symbol];
+        codes[symbol].length = length;
+        codes[symbol].bits = (length == 0) ? 0 : reverseBits(nextCode[length]++, length);
+    }
+}
+
+/* Constructor: CodeTable
+ * -----------------------
+ * Canonical codes are written right into the table.
+ */
+CodeTable::CodeTable(const CodeLengths& lengths) {
+    assignCanonicalCodes(lengths, codes);
+}
+
+/* Constructor: DecodeTable
+ * -------------------------
+ * At first finds the longest code behind every primary
+ * index, to size secondary tables. Then every code is
+ * written into all cells whose low bits are equal to it.
+ */
+DecodeTable::DecodeTable(const CodeLengths& lengths) {
+    int symbolCount = lengths.size();
+    SymbolCode codes[MAX_ALPHABET_SIZE];
+    assignCanonicalCodes(lengths, codes);
+
+    DecodeEntry emptyEntry = {NOT_A_CHAR, 0, 0, 0};
+    primary.assign(1 << DECODE_PRIMARY_BITS, emptyEntry);
+
+    /* Longest code for every primary index */
+    vector<int> maxLength(1 << DECODE_PRIMARY_BITS, 0);
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        if (codes[symbol].length > DECODE_PRIMARY_BITS) {
+            int index = codes[symbol].bits & PRIMARY_MASK;
+            maxLength[index] = max(maxLength[index], codes[symbol].length);
+        }
+    }
+
+    /* Links to secondary tables */
+    for (int index = 0; index < (int) maxLength.size(); index++) {
+        int subBits = maxLength[index] - DECODE_PRIMARY_BITS;
+        if (subBits > 0) {
+            primary[index].subBits = subBits;
+            primary[index].subTable = secondary.size();
+            secondary.resize(secondary.size() + (1 << subBits), emptyEntry);
+        }
+    }
+
+    /* Symbols cells */
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        const SymbolCode& code = codes[symbol];
+        if (code.length == 0) {
+            continue;
+        }
+        DecodeEntry entry = {symbol, (unsigned char) code.length, 0, 0};
+        if (code.length <= DECODE_PRIMARY_BITS) {
+            for (unsigned index = code.bits; index < primary.size(); index += (1u << code.length)) {
+                primary[index] = entry;
+            }
+        } else {
+            const DecodeEntry& link = primary[code.bits & PRIMARY_MASK];
+            unsigned rest = code.bits >> DECODE_PRIMARY_BITS;
+            int restLength = code.length - DECODE_PRIMARY_BITS;
+            for (unsigned index = rest; index < (1u << link.subBits); index += (1u << restLength)) {
+                secondary[link.subTable + index] = entry;
+            }
+        }
+    }
+}
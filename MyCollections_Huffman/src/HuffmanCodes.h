@@ -0,0 +1,189 @@
+/*******************************************************
+* File: HuffmanCodes.h
+* --------------------------
+* v.2 2026/10/18
+* - codes are canonical, built from code lengths only
+* - code lengths are limited by MAX_CODE_LENGTH
+*
+* v.3 2026/10/18
+* - code lengths are taken from HuffmanTree array
+*
+* v.4 2026/10/18
+* - getWeightsCodeLengths() builds lengths without tree
+*
+* v.5 2026/10/18
+* - tables of any alphabet up to MAX_ALPHABET_SIZE symbols
+*
+* v.6 2026/10/18
+* - getTreeCodeLengths() is removed
+*
+* Lookup tables of canonical Huffman codes, which replace
+* bit by bit tree traversing during coding.
+*******************************************************/
+
+#ifndef HuffmanCodes_Included
+#define HuffmanCodes_Included
+
+#include <vector>
+#include "HuffmanTypes.h"
+
+/* Constant: CODE_TABLE_SIZE
+ * Count of coded symbols: every byte value and
+ * PSEUDO_EOF in the last cell.
+ */
+const int CODE_TABLE_SIZE = PSEUDO_EOF + 1;
+
+/* Constant: MAX_ALPHABET_SIZE
+ * The biggest count of symbols of code tables - bytes,
+ * end symbol and LZ77 match lengths (see HuffmanLz77.h).
+ */
+const int MAX_ALPHABET_SIZE = 288;
+
+/* Constant: MAX_CODE_LENGTH
+ * The longest code length, which could be stored in the
+ * file header. Lengths could be limited even more by user.
+ */
+const int MAX_CODE_LENGTH = 15;
+
+/* Constant: MIN_CODE_LENGTH_LIMIT
+ * The smallest length limit, which still has place
+ * for codes of all CODE_TABLE_SIZE symbols.
+ */
+const int MIN_CODE_LENGTH_LIMIT = 9;
+
+/* Type: CodeLengths
+ * Code length for every symbol, from 0 to PSEUDO_EOF, or
+ * for every symbol of other alphabet. Length 0 means symbol
+ * has no code.
+ */
+typedef std::vector<int> CodeLengths;
+
+/* Function: getWeightsCodeLengths
+ * Usage: CodeLengths lengths = getWeightsCodeLengths(weights);
+ *        CodeLengths lengths = getWeightsCodeLengths(weights, symbolCount);
+ * ----------------------------------------------------------------------
+ * Returns Huffman code lengths for symbolCount symbol weights,
+ * where weight 0 means symbol is absent. No tree nodes are
+ * made: weights are sorted once, and lengths are found in
+ * place of them. Single symbol gets length 1.
+ */
+CodeLengths getWeightsCodeLengths(const long long* weights,
+                                  int symbolCount = CODE_TABLE_SIZE);
+
+/* Function: limitCodeLengths
+ * Usage: limitCodeLengths(lengths, maxCodeLength);
+ * ------------------------------------------------
+ * Makes every length not bigger then maxCodeLength, so that
+ * lengths still form prefix code. Symbols with shorter codes
+ * keep the shorter ones after limiting.
+ */
+void limitCodeLengths(CodeLengths& lengths, int maxCodeLength);
+
+/* Type: SymbolCode
+ * Huffman code of one symbol as integer. Stream bits of
+ * the code go from the lowest bit of bits field. Length 0
+ * means symbol has no code.
+ */
+struct SymbolCode {
+    unsigned bits;
+    int length;
+};
+
+/*
+ * Class: CodeTable
+ * ----------------
+ * Flat encoding table of canonical codes, indexed by
+ * byte value or PSEUDO_EOF (or by symbol of other alphabet).
+ */
+class CodeTable {
+public:
+    /*
+     * Constructor: CodeTable
+     * Usage: CodeTable codes(lengths);
+     * --------------------------------
+     * Assigns canonical codes for code lengths.
+     */
+    CodeTable(const CodeLengths& lengths);
+
+    /*
+     * Operator: []
+     * Usage: SymbolCode code = codes[byte];
+     * -------------------------------------
+     * Returns code for byte value or PSEUDO_EOF.
+     */
+    const SymbolCode& operator [](int symbol) const {
+        return codes[symbol];
+    }
+
+private:
+    SymbolCode codes[MAX_ALPHABET_SIZE];
+};
+
+/* Constant: DECODE_PRIMARY_BITS
+ * Count of stream bits which index primary decoding table.
+ * Codes up to this length are decoded by single lookup,
+ * longer ones - by one more secondary table lookup.
+ */
+const int DECODE_PRIMARY_BITS = 11;
+
+/* Type: DecodeEntry
+ * One cell of decoding table. Two kinds of cells:
+ * - length > 0 - symbol cell, the code of symbol has such length;
+ * - length == 0, subBits > 0 - link to secondary table, which
+ *   starts at subTable and is indexed by next subBits bits.
+ * Cells with zeros only are not used by any code.
+ */
+struct DecodeEntry {
+    ext_char symbol;
+    unsigned char length;
+    unsigned char subBits;
+    int subTable;
+};
+
+/*
+ * Class: DecodeTable
+ * ------------------
+ * Two level decoding table of canonical codes.
+ * Stream bits go from the lowest bit of every byte, as
+ * BitWriter writes them, so table index is next bits of
+ * stream as little-endian number.
+ */
+class DecodeTable {
+public:
+    /*
+     * Constructor: DecodeTable
+     * Usage: DecodeTable table(lengths);
+     * ----------------------------------
+     * Fills tables by canonical codes for code lengths,
+     * which are not longer then MAX_CODE_LENGTH.
+     */
+    DecodeTable(const CodeLengths& lengths);
+
+    /*
+     * Method: decode
+     * Usage: int length = table.decode(bits, bitCount, symbol);
+     * ---------------------------------------------------------
+     * Decodes symbol from the lowest bits of bits param, where
+     * bitCount bits are valid. Returns code length, or 0 if
+     * valid bits are not enough for the whole code, or bits
+     * are not a code at all.
+     */
+    int decode(unsigned long long bits, int bitCount, ext_char& symbol) const {
+        const DecodeEntry* entry = &primary[bits & PRIMARY_MASK];
+        if (entry->subBits != 0) {
+            unsigned index = (bits >> DECODE_PRIMARY_BITS) & ((1u << entry->subBits) - 1);
+            entry = &secondary[entry->subTable + index];
+        }
+        if ((entry->length == 0) || (entry->length > bitCount)) return 0;
+        symbol = entry->symbol;
+        return entry->length;
+    }
+
+private:
+    static const unsigned PRIMARY_MASK = (1u << DECODE_PRIMARY_BITS) - 1;
+
+    std::vector<DecodeEntry> primary;
+    std::vector<DecodeEntry> secondary;
+};
+
+#endif
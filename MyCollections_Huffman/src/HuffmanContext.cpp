@@ -0,0 +1,262 @@
+/**********************************************************
+* File: HuffmanContext.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - cluster costs by histogramBits()
+*
+* Implementation of the functions from HuffmanContext.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "HuffmanContext.h"
+#include "HuffmanCodes.h"
+#include "HuffmanEncoding.h"
+#include "HuffmanDecoding.h"
+#include "HuffmanHistogram.h"
+#include "bitio.h"
+
+using namespace std;
+
+/* Constant: CONTEXT_SYMBOLS_PER_REFILL
+ * Count of the longest codes, which fit into 57 bits
+ * that one refill of BitReader guarantees.
+ */
+static const int CONTEXT_SYMBOLS_PER_REFILL = 57 / MAX_CODE_LENGTH;
+
+/* Constant: CONTEXT_TABLE_COST
+ * Approximate count of bits of one more code table in
+ * block data: presence bits and some code lengths.
+ */
+static const double CONTEXT_TABLE_COST = BYTE_VALUES + 64 * HEADER_LENGTH_BITS;
+
+/* Function: sumClusters
+ * ---------------------
+ * Sums counts of contexts of every cluster.
+ */
+static void sumClusters(const vector<long long>& pairCounts, const int* contextClusters,
+                        int clusterCount, vector<long long>& clusterCounts) {
+    clusterCounts.assign(clusterCount * BYTE_VALUES, 0);
+    for (int context = 0; context < BYTE_VALUES; context++) {
+        long long* target = &clusterCounts[contextClusters[context] * BYTE_VALUES];
+        const long long* source = &pairCounts[context * BYTE_VALUES];
+        for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+            target[symbol] += source[symbol];
+        }
+    }
+}
+
+/* Function: clusterContexts
+ * -------------------------
+ * Costs of symbols of cluster are smoothed by half of count,
+ * so context with new symbols still could join it. At the
+ * end clusters are merged while merged table is cheaper then
+ * two tables, and empty clusters are dropped.
+ */
+int clusterContexts(const vector<long long>& pairCounts, int* contextClusters) {
+    long long contextTotals[BYTE_VALUES];
+    vector<int> contexts;
+    for (int context = 0; context < BYTE_VALUES; context++) {
+        contextTotals[context] = 0;
+        for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+            contextTotals[context] += pairCounts[context * BYTE_VALUES + symbol];
+        }
+        contextClusters[context] = 0;
+        if (contextTotals[context] > 0) {
+            contexts.push_back(context);
+        }
+    }
+    if (contexts.empty()) return 1;
+
+    /* Seeds - the most frequent contexts */
+    sort(contexts.begin(), contexts.end(), [&contextTotals](int a, int b) {
+        return contextTotals[a] > contextTotals[b];
+    });
+    int clusterCount = min((int) contexts.size(), CONTEXT_CLUSTERS);
+    for (size_t i = 0; i < contexts.size(); i++) {
+        contextClusters[contexts[i]] = (i < (size_t) clusterCount) ? (int) i : 0;
+    }
+
+    vector<long long> clusterCounts;
+    vector<double> symbolCosts(CONTEXT_CLUSTERS * BYTE_VALUES);
+    for (int round = 0; round < CONTEXT_CLUSTERING_ROUNDS; round++) {
+        sumClusters(pairCounts, contextClusters, clusterCount, clusterCounts);
+        for (int cluster = 0; cluster < clusterCount; cluster++) {
+            const long long* counts = &clusterCounts[cluster * BYTE_VALUES];
+            double total = 0;
+            for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+                total += counts[symbol] + 0.5;
+            }
+            for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+                symbolCosts[cluster * BYTE_VALUES + symbol] = log2(total / (counts[symbol] + 0.5));
+            }
+        }
+        for (int context : contexts) {
+            const long long* counts = &pairCounts[context * BYTE_VALUES];
+            double bestCost = 0;
+            for (int cluster = 0; cluster < clusterCount; cluster++) {
+                const double* costs = &symbolCosts[cluster * BYTE_VALUES];
+                double cost = 0;
+                for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+                    cost += counts[symbol] * costs[symbol];
+                }
+                if ((cluster == 0) || (cost < bestCost)) {
+                    bestCost = cost;
+                    contextClusters[context] = cluster;
+                }
+            }
+        }
+    }
+
+    /* Drop empty clusters */
+    sumClusters(pairCounts, contextClusters, clusterCount, clusterCounts);
+    int clusterIds[CONTEXT_CLUSTERS];
+    int usedCount = 0;
+    for (int cluster = 0; cluster < clusterCount; cluster++) {
+        bool isUsed = false;
+        for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+            isUsed = isUsed || (clusterCounts[cluster * BYTE_VALUES + symbol] > 0);
+        }
+        clusterIds[cluster] = isUsed ? usedCount++ : 0;
+    }
+    for (int context = 0; context < BYTE_VALUES; context++) {
+        contextClusters[context] = clusterIds[contextClusters[context]];
+    }
+    clusterCount = usedCount;
+
+    /* Merge clusters, while one table is cheaper then two */
+    while (clusterCount > 1) {
+        sumClusters(pairCounts, contextClusters, clusterCount, clusterCounts);
+        vector<double> costs(clusterCount);
+        for (int cluster = 0; cluster < clusterCount; cluster++) {
+            costs[cluster] = histogramBits(&clusterCounts[cluster * BYTE_VALUES]);
+        }
+        double bestGain = 0;
+        int bestFirst = -1;
+        int bestSecond = -1;
+        long long merged[BYTE_VALUES];
+        for (int first = 0; first < clusterCount; first++) {
+            for (int second = first + 1; second < clusterCount; second++) {
+                for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+                    merged[symbol] = clusterCounts[first * BYTE_VALUES + symbol]
+                            + clusterCounts[second * BYTE_VALUES + symbol];
+                }
+                double gain = costs[first] + costs[second] + CONTEXT_TABLE_COST
+                        - histogramBits(merged);
+                if (gain > bestGain) {
+                    bestGain = gain;
+                    bestFirst = first;
+                    bestSecond = second;
+                }
+            }
+        }
+        if (bestFirst < 0) break;
+        for (int context = 0; context < BYTE_VALUES; context++) {
+            if (contextClusters[context] == bestSecond) {
+                contextClusters[context] = bestFirst;
+            } else if (contextClusters[context] == clusterCount - 1) {
+                contextClusters[context] = bestSecond;
+            }
+        }
+        clusterCount--;
+    }
+    return clusterCount;
+}
+
+/* Function: encodeContextBlock
+ * ----------------------------
+ * Counts pairs of previous and next bytes, groups contexts,
+ * and then codes every byte by table of its context cluster.
+ */
+void encodeContextBlock(const unsigned char* text, size_t size,
+                        int maxCodeLength, vector<char>& data) {
+    vector<long long> pairCounts(BYTE_VALUES * BYTE_VALUES, 0);
+    unsigned char previous = 0;
+    for (size_t i = 0; i < size; i++) {
+        pairCounts[previous * BYTE_VALUES + text[i]]++;
+        previous = text[i];
+    }
+    int contextClusters[BYTE_VALUES];
+    int clusterCount = clusterContexts(pairCounts, contextClusters);
+    vector<long long> clusterCounts;
+    sumClusters(pairCounts, contextClusters, clusterCount, clusterCounts);
+
+    BitWriter writer(data);
+    writer.writeBits(clusterCount - 1, CONTEXT_CLUSTER_BITS);
+    if (clusterCount > 1) {
+        for (int context = 0; context < BYTE_VALUES; context++) {
+            writer.writeBits(contextClusters[context], CONTEXT_CLUSTER_BITS);
+        }
+    }
+    writer.alignToByte();
+
+    vector<CodeTable> clusterCodes;
+    for (int cluster = 0; cluster < clusterCount; cluster++) {
+        CodeLengths lengths = getWeightsCodeLengths(&clusterCounts[cluster * BYTE_VALUES],
+                                                    BYTE_VALUES);
+        limitCodeLengths(lengths, maxCodeLength);
+        encodeCodeLengths(lengths, writer);
+        clusterCodes.push_back(CodeTable(lengths));
+    }
+    const CodeTable* contextCodes[BYTE_VALUES];
+    for (int context = 0; context < BYTE_VALUES; context++) {
+        contextCodes[context] = &clusterCodes[contextClusters[context]];
+    }
+
+    previous = 0;
+    for (size_t i = 0; i < size; i++) {
+        const SymbolCode& code = (*contextCodes[previous])[text[i]];
+        writer.writeBits(code.bits, code.length);
+        previous = text[i];
+    }
+}
+
+/* Function: decodeContextBlock
+ * ----------------------------
+ * Table of next byte depends on the byte just decoded, so
+ * bytes are decoded one after another, with one refill for
+ * CONTEXT_SYMBOLS_PER_REFILL bytes.
+ */
+bool decodeContextBlock(const char* data, size_t dataSize, char* text, size_t textSize) {
+    BitReader reader(data, dataSize);
+    long long value = reader.readBits(CONTEXT_CLUSTER_BITS);
+    if (value == EOF) return false;
+    int clusterCount = (int) value + 1;
+    int contextClusters[BYTE_VALUES] = {0};
+    if (clusterCount > 1) {
+        for (int context = 0; context < BYTE_VALUES; context++) {
+            value = reader.readBits(CONTEXT_CLUSTER_BITS);
+            if ((value == EOF) || (value >= clusterCount)) return false;
+            contextClusters[context] = (int) value;
+        }
+    }
+    reader.alignToByte();
+
+    vector<DecodeTable> clusterTables;
+    for (int cluster = 0; cluster < clusterCount; cluster++) {
+        CodeLengths lengths;
+        if (!readCodeLengths(reader, lengths, BYTE_VALUES)) return false;
+        clusterTables.push_back(DecodeTable(lengths));
+    }
+    const DecodeTable* contextTables[BYTE_VALUES];
+    for (int context = 0; context < BYTE_VALUES; context++) {
+        contextTables[context] = &clusterTables[contextClusters[context]];
+    }
+
+    size_t pos = 0;
+    ext_char previous = 0;
+    while (pos < textSize) {
+        reader.refill();
+        size_t roundEnd = min(textSize, pos + CONTEXT_SYMBOLS_PER_REFILL);
+        for (; pos < roundEnd; pos++) {
+            int length = contextTables[previous]->decode(reader.peek(), reader.available(), previous);
+            if (length == 0) return false;
+            reader.consume(length);
+            text[pos] = (char) previous;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+/*******************************************************
+* File: HuffmanContext.h
+* --------------------------
+* v.1 2026/10/18
+*
+* Order-1 context coding of text blocks. Every byte is
+* coded by the code table of its previous byte context, so
+* letters after "q" and after space get own short codes.
+* Contexts with similar statistics are grouped into at most
+* CONTEXT_CLUSTERS clusters, which share one table, so the
+* block keeps only few tables.
+*
+* Block data format:
+* - CONTEXT_CLUSTER_BITS bits of (cluster count - 1);
+* - CONTEXT_CLUSTER_BITS bits of cluster of every previous
+*   byte value, if there are more then one cluster;
+*   zero bits up to the next byte;
+* - code lengths of BYTE_VALUES symbols of every cluster
+*   (see encodeCodeLengths);
+* - codes of text bytes, zero bits up to the next byte.
+* Previous byte of the first block byte is 0.
+*******************************************************/
+
+#ifndef HuffmanContext_Included
+#define HuffmanContext_Included
+
+#include <cstddef>
+#include <vector>
+
+/* Constants: CONTEXT_CLUSTER_BITS, CONTEXT_CLUSTERS
+ * The biggest count of code tables of one block.
+ */
+const int CONTEXT_CLUSTER_BITS = 4;
+const int CONTEXT_CLUSTERS = 1 << CONTEXT_CLUSTER_BITS;
+
+/* Constant: CONTEXT_CLUSTERING_ROUNDS
+ * Count of rounds, where every context moves to the
+ * cluster, which codes it the shortest way.
+ */
+const int CONTEXT_CLUSTERING_ROUNDS = 4;
+
+/* Function: clusterContexts
+ * Usage: int clusterCount = clusterContexts(pairCounts, contextClusters);
+ * -----------------------------------------------------------------------
+ * Groups previous byte contexts by their counts of next bytes
+ * (BYTE_VALUES x BYTE_VALUES table). Writes cluster of every
+ * context into contextClusters, and returns count of clusters.
+ * The most frequent contexts are seeds of clusters, and then
+ * every context joins the cluster of the least coding cost.
+ */
+int clusterContexts(const std::vector<long long>& pairCounts, int* contextClusters);
+
+/* Function: encodeContextBlock
+ * Usage: encodeContextBlock(text, size, maxCodeLength, data);
+ * -----------------------------------------------------------
+ * Codes text block by code tables of contexts clusters, and
+ * appends them with codes to data vector.
+ */
+void encodeContextBlock(const unsigned char* text, size_t size,
+                        int maxCodeLength, std::vector<char>& data);
+
+/* Function: decodeContextBlock
+ * Usage: if (decodeContextBlock(data, dataSize, text, textSize)) ...
+ * ------------------------------------------------------------------
+ * Decodes textSize bytes from block data. Returns false if
+ * data is broken.
+ */
+bool decodeContextBlock(const char* data, size_t dataSize, char* text, size_t textSize);
+
+#endif
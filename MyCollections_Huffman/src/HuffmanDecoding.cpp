@@ -7,98 +7,261 @@
 * - code fields renamed
 * - code formatted
 *
+* v.3 2026/10/18
+* - decodeFileToFile() uses DecodeTable lookups
+* - all bits are read by buffered BitReader
+*
+* v.4 2026/10/18
+* - readFileHeader() reads code lengths, no tree is built
+* - text is ended by PSEUDO_EOF code
+*
+* v.5 2026/10/18
+* - decompress() decodes block containers by thread pool
+* - single stream files are read from memory
+*
+* v.6 2026/10/18
+* - decompressRange() decodes text range by block index
+*
+* v.7 2026/10/18
+* - decompressStream() for pipes
+*
+* v.8 2026/10/18
+* - decompress() decodes adaptive streams
+*
+* v.9 2026/10/18
+* - decodeInterleavedText() decodes all streams at once
+*
+* v.10 2026/10/18
+* - readCodeLengths() of any alphabet
+*
+* v.11 2026/10/18
+* - decodeFileToFile() writes into any ostream
+*
+* v.12 2026/10/18
+* - adaptive streams are decoded from mapped bytes
+*
+* v.13 2026/10/18
+* - decompress() reports error if out file can't be written
+*
+* v.14 2026/10/18
+* - single stream files are not read, readFileHeader() and
+*   decodeFileToFile() are removed
+*
 * Implementation of the functions from HuffmanEncoding.h.
 *
 **********************************************************/
 
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "error.h"
 #include "HuffmanDecoding.h"
-#include "HuffmanEncoding.h" //To import deleteTree
 #include "HuffmanTypes.h"
+#include "HuffmanAdaptive.h"
+#include "HuffmanBlocks.h"
+#include "mappedfile.h"
 
 using namespace std;
 
-
-/* Function: readFileHeader
- * Reads header of cyphered file and reconstructs huffman tree
+/* Function: readCodeLengths
+ * Usage: if (readCodeLengths(reader, lengths)) ...
  * --------------------------------------------------------
- * Reads header of cyphered file and reconstructs huffman tree
- * for this cypher file
+ * Reads presence bits and code lengths of present symbols.
+ * Returns false if lengths are not a prefix code. Alphabets,
+ * which have PSEUDO_EOF, have to have its code.
  */
-void readFileHeader(ibstream& infileStream, Node* root) {
-    /* Recursive header decoding */
-    int bit = 0;
-    if ((bit = infileStream.readBit()) > -1) {
-        if (bit == 1) {//It's a tree leaf
-            /* We write followed symbol into leaf node */
-            ext_char nodeSymb = infileStream.get();
-            root->symbol = nodeSymb;
-        }else if (bit == 0) {//It's a tree knot
-            /* We have to create children for it */
-            root->symbol = NOT_A_CHAR;
-            Node* leftChild = new Node;
-            Node* rightChild = new Node;
-            root->leftChild = leftChild;
-            root->rightChild = rightChild;
-            /* Move to children */
-            readFileHeader(infileStream, leftChild);
-            readFileHeader(infileStream, rightChild);
-        }
+bool readCodeLengths(BitReader& reader, CodeLengths& lengths, int symbolCount) {
+    /* Symbols presence bits */
+    lengths.assign(symbolCount, 0);
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        int bit = reader.readBit();
+        if (bit == EOF) return false;
+        lengths[symbol] = bit;
+    }
+
+    /* Lengths of present symbols, checked by Kraft sum */
+    long kraftSum = 0;
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        if (lengths[symbol] == 0) continue;
+        long long length = reader.readBits(HEADER_LENGTH_BITS);
+        if ((length == EOF) || (length == 0)) return false;
+        lengths[symbol] = (int) length;
+        kraftSum += 1L << (MAX_CODE_LENGTH - length);
     }
+    if (kraftSum > (1L << MAX_CODE_LENGTH)) return false;
+    if ((symbolCount > PSEUDO_EOF) && (lengths[PSEUDO_EOF] == 0)) return false;
+
+    reader.alignToByte();
+    return true;
 }
 
-/* Function: decodeFileToFile
- * --------------------------
+/* Function: decodeTextToBuffer
+ * ----------------------------
  * Main cyphered text decoding process.
+ * Every symbol is found by DecodeTable lookup on the next
+ * stream bits, instead of one tree step per bit, and is
+ * written into text buffer of capacity bytes.
+ */
+long long decodeTextToBuffer(BitReader& reader, const CodeLengths& lengths,
+                             char* text, size_t capacity) {
+    DecodeTable table(lengths);
+    size_t textPos = 0;
+    while (true) {
+        reader.refill();
+        ext_char symbol;
+        int codeLength = table.decode(reader.peek(), reader.available(), symbol);
+        if (codeLength == 0) {
+            return -1;//Stream is over without EOF code
+        }
+        reader.consume(codeLength);
+
+        if (symbol == PSEUDO_EOF) {
+            return textPos;
+        }
+        if (textPos == capacity) {
+            return -1;
+        }
+        text[textPos++] = (char) symbol;
+    }
+}
+
+/* Constant: SYMBOLS_PER_REFILL
+ * Count of the longest codes, which fit into 57 bits
+ * that one refill of BitReader guarantees.
  */
-void decodeFileToFile(ibstream& infileStream, Node* root, obstream& outfileStream) {
-    int bit;
-    Node* currentNode = root;
-    /* Runs through every cypher bit and, at the same time, move
-     * through tree to symbols leafs */
-    while ((bit = infileStream.readBit()) > -1) {
-        if (bit == 0) {
-            currentNode = currentNode->leftChild;
-        }else{
-            currentNode = currentNode->rightChild;
+static const int SYMBOLS_PER_REFILL = 57 / MAX_CODE_LENGTH;
+
+/* Function: decodeInterleavedText
+ * -------------------------------
+ * Streams are independent, so CPU runs table lookups of all
+ * of them at the same time, while the main loop decodes one
+ * symbol of every stream by turns. Errors are checked once
+ * per round: failed lookup leaves PSEUDO_EOF in symbol, and
+ * PSEUDO_EOF is wrong in the text too. Ends of the longer
+ * parts are decoded by one stream at once.
+ */
+bool decodeInterleavedText(const char* data, size_t size, const CodeLengths& lengths,
+                           char* text, size_t textSize) {
+    if (size < INTERLEAVED_JUMP_TABLE_SIZE) return false;
+    size_t streamStarts[INTERLEAVED_STREAMS + 1];
+    streamStarts[0] = INTERLEAVED_JUMP_TABLE_SIZE;
+    for (int i = 0; i < INTERLEAVED_STREAMS - 1; i++) {
+        size_t streamSize = 0;
+        for (int j = 0; j < 4; j++) {
+            streamSize |= (size_t) (unsigned char) data[4 * i + j] << (8 * j);
+        }
+        if (streamSize > size - streamStarts[i]) return false;
+        streamStarts[i + 1] = streamStarts[i] + streamSize;
+    }
+    streamStarts[INTERLEAVED_STREAMS] = size;
+
+    vector<BitReader> readers;
+    char* textPos[INTERLEAVED_STREAMS];
+    char* textEnd[INTERLEAVED_STREAMS];
+    for (int i = 0; i < INTERLEAVED_STREAMS; i++) {
+        readers.push_back(BitReader(data + streamStarts[i], streamStarts[i + 1] - streamStarts[i]));
+        textPos[i] = text + textSize * i / INTERLEAVED_STREAMS;
+        textEnd[i] = text + textSize * (i + 1) / INTERLEAVED_STREAMS;
+    }
+
+    DecodeTable table(lengths);
+    size_t rounds = (textSize / INTERLEAVED_STREAMS) / SYMBOLS_PER_REFILL;
+    for (size_t round = 0; round < rounds; round++) {
+        ext_char failed = 0;
+        for (int i = 0; i < INTERLEAVED_STREAMS; i++) {
+            readers[i].refill();
         }
-        if ((currentNode->symbol) < NOT_A_CHAR) {
-            if (((char)currentNode->symbol) == EOF) {
-                break;
-            }else{
-                outfileStream.put((char)(currentNode->symbol));
+        for (int k = 0; k < SYMBOLS_PER_REFILL; k++) {
+            for (int i = 0; i < INTERLEAVED_STREAMS; i++) {
+                ext_char symbol = PSEUDO_EOF;
+                readers[i].consume(table.decode(readers[i].peek(), readers[i].available(), symbol));
+                *textPos[i]++ = (char) symbol;
+                failed |= symbol;
             }
-            currentNode = root;
         }
+        if (failed >= PSEUDO_EOF) return false;
     }
+
+    for (int i = 0; i < INTERLEAVED_STREAMS; i++) {
+        while (textPos[i] < textEnd[i]) {
+            readers[i].refill();
+            ext_char symbol = PSEUDO_EOF;
+            readers[i].consume(table.decode(readers[i].peek(), readers[i].available(), symbol));
+            if (symbol == PSEUDO_EOF) return false;
+            *textPos[i]++ = (char) symbol;
+        }
+    }
+    return true;
 }
 
 /* Function: decompress
  * Usage: decompress(cypherFile, outFile);
  * ---------------------------------------
- * Decompresses cypherFile into outfile.
+ * Decompresses cypherFile into outfile. Block containers
+ * are decoded by threadCount threads, and adaptive streams -
+ * by current thread.
  */
-void decompress(string cypherFile, string outFile) {
+void decompress(string cypherFile, string outFile, int threadCount) {
     cout << "    - WAIT, CYPHER FILE \"" << cypherFile << "\" IS BEING DECODED..." << endl;
-    ifbstream infileStream;
-    infileStream.open(cypherFile.c_str());
-    //ibStream.rewind();
+    MappedFile input(cypherFile);
+    if (!input.isOpen()) {
+        error("decompress: Can't read file \"" + cypherFile + "\"");
+    }
+    const char* data = (const char*) input.data();
     ofbstream outfileStream;
     outfileStream.open(outFile.c_str());
+    if (!outfileStream.is_open()) {
+        error("decompress: Can't write file \"" + outFile + "\"");
+    }
 
-    Node* huffmanTreeRoot = new Node;
-    /* Gets Huffman tree from the header */
-    readFileHeader(infileStream, huffmanTreeRoot);
-
-    infileStream.get();//get some redundant charr
-
-    /* Main decoding process */
-    decodeFileToFile(infileStream, huffmanTreeRoot, outfileStream);
-
-    deleteTree(huffmanTreeRoot);
+    if (isBlockContainer(data, input.size())) {
+        ThreadPool pool(threadCount);
+        decompressBlocks(data, input.size(), outfileStream, pool);
+    } else if (isAdaptiveStream(data, input.size())) {
+        MemoryBuffer cypherBuffer(data, input.size());
+        istream cypherStream(&cypherBuffer);
+        decompressAdaptiveStream(cypherStream, outfileStream);
+    } else {
+        error("decompress: \"" + cypherFile + "\" is not a Huffman cypher file");
+    }
 
-    infileStream.close();
     outfileStream.close();
+    if (outfileStream.fail()) {
+        error("decompress: Can't write file \"" + outFile + "\"");
+    }
     cout << "    - CYPHER FILE DECODING COMPLETE TO FILE: \"" << outFile << "\"" << endl;
     cout << "==========================================================" << endl;
     cout << "ALL FILES ARE SAVED INTO PROJECT BUILD FOLDER!" << endl;
 }
+
+/* Function: decompressRange
+ * Usage: string text = decompressRange(cypherFile, offset, length);
+ * -----------------------------------------------------------------
+ * Maps cypherFile and decodes only blocks of the range.
+ * Adaptive streams have no block index, so they are
+ * not supported.
+ */
+string decompressRange(string cypherFile, long long offset, long long length) {
+    MappedFile input(cypherFile);
+    if (!input.isOpen()) {
+        error("decompressRange: Can't read file \"" + cypherFile + "\"");
+    }
+    const char* data = (const char*) input.data();
+    if (!isBlockContainer(data, input.size())) {
+        error("decompressRange: \"" + cypherFile + "\" has no block index");
+    }
+    ostringstream text;
+    decompressBlocksRange(data, input.size(), offset, length, text);
+    return text.str();
+}
+
+/* Function: decompressStream
+ * Usage: decompressStream(cin, cout);
+ * -----------------------------------
+ * Blocks are found by their headers, so stream isn't
+ * seeked and could be a pipe. Nothing is printed to cout.
+ */
+void decompressStream(istream& in, ostream& out, int threadCount) {
+    ThreadPool pool(threadCount);
+    decompressBlocksStream(in, out, pool);
+}
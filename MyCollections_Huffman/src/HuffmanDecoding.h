@@ -6,6 +6,31 @@
 * - code formatted
 * - code fields renamed
 *
+* v.3 2026/10/18
+* - header keeps code lengths of canonical codes
+*
+* v.4 2026/10/18
+* - decompress() reads block containers too
+*
+* v.5 2026/10/18
+* - decompressRange() is added
+*
+* v.6 2026/10/18
+* - decompressStream() is added
+*
+* v.7 2026/10/18
+* - decodeInterleavedText() is added
+*
+* v.8 2026/10/18
+* - readCodeLengths() has alphabet size param
+*
+* v.9 2026/10/18
+* - decodeFileToFile() writes into any ostream
+*
+* v.10 2026/10/18
+* - readFileHeader(), decodeFileToFile() are removed, as
+*   single stream files are not written any more
+*
 * Definitions for the functions necessary to build a
 * Huffman encoding system.
 *
@@ -24,28 +49,66 @@
 #include "console.h"
 #include "strlib.h"
 #include "bstream.h"
+#include "bitio.h"
 #include "HuffmanDecoding.h"
 #include "HuffmanTypes.h"
+#include "HuffmanCodes.h"
 
 
-/* Function: readFileHeader
+/* Function: readCodeLengths
  * --------------------------------------------------------
- * Reads header of cyphered file and reconstructs huffman tree
- * for this cypher file
+ * Reads code lengths only, without magic bytes - as every
+ * block of block container has. Returns false if lengths
+ * are not valid. symbolCount is size of the alphabet.
  */
-void readFileHeader(ibstream& infileStream, Node* root);
+bool readCodeLengths(BitReader& reader, CodeLengths& lengths,
+                     int symbolCount = CODE_TABLE_SIZE);
 
-/* Function: decodeFileToFile
- * --------------------------
- * Main cyphered text decoding process.
+/* Function: decodeTextToBuffer
+ * Usage: long long size = decodeTextToBuffer(reader, lengths, text, capacity);
+ * ----------------------------------------------------------------------------
+ * Decodes text up to PSEUDO_EOF code into text buffer. Returns
+ * count of decoded bytes, or -1 if the stream is broken or
+ * text is longer then capacity.
  */
-void decodeFileToFile(ibstream &infileStream, Node* root, obstream &outfileStream);
+long long decodeTextToBuffer(BitReader &reader, const CodeLengths &lengths,
+                             char* text, size_t capacity);
+
+/* Function: decodeInterleavedText
+ * Usage: if (decodeInterleavedText(data, size, lengths, text, textSize)) ...
+ * --------------------------------------------------------------------------
+ * Decodes jump table and streams, which encodeInterleavedText
+ * wrote, into textSize bytes of text. Returns false if data
+ * is broken.
+ */
+bool decodeInterleavedText(const char* data, size_t size, const CodeLengths &lengths,
+                           char* text, size_t textSize);
 
 /* Function: decompress
  * Usage: decompress(cypherFile, outFile);
  * --------------------------------------------------------
- * Decompresses cypherFile into outfile.
+ * Decompresses cypherFile into outfile. Blocks of block
+ * container are decoded by threadCount threads (0 - by
+ * all hardware threads). Adaptive streams are decoded too.
+ */
+void decompress(string cypherFile, string outFile, int threadCount = 0);
+
+/* Function: decompressRange
+ * Usage: string text = decompressRange(cypherFile, offset, length);
+ * --------------------------------------------------------
+ * Returns length bytes of the original text from offset,
+ * or less if the text ends before. Only blocks of this range
+ * are decoded, so cypherFile has to be block container.
+ */
+string decompressRange(string cypherFile, long long offset, long long length);
+
+/* Function: decompressStream
+ * Usage: decompressStream(cin, cout);
+ * --------------------------------------------------------
+ * Decompresses block container from in stream into out,
+ * block by block, with bounded memory. Adaptive streams
+ * are not supported.
  */
-void decompress(string cypherFile, string outFile);
+void decompressStream(istream& in, ostream& out, int threadCount = 0);
 
 #endif
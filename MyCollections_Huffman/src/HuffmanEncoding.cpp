@@ -7,12 +7,74 @@
 * - code fields renamed
 * - some decomposition is included
 *
+* v.3 2026/10/18
+* - codes are integers from flat CodeTable
+* - encodeMainTextToFile() uses 64-bit bit accumulator
+* - all bits are written by buffered BitWriter
+*
+* v.4 2026/10/18
+* - canonical codes, header keeps code lengths only
+* - PSEUDO_EOF ends the text, so 0xFF bytes are coded too
+* - code lengths could be limited by compress() param
+*
+* v.5 2026/10/18
+* - getFrequencyTable() counts bytes by histogram kernel
+*
+* v.6 2026/10/18
+* - compress() maps input file once for both passes
+* - output is written by big BitWriter buffer
+*
+* v.7 2026/10/18
+* - compress() writes block container by thread pool
+*
+* v.8 2026/10/18
+* - compressStream() for pipes
+*
+* v.9 2026/10/18
+* - encodeInterleavedText() for interleaved blocks
+*
+* v.10 2026/10/18
+* - tree is built in HuffmanTree array, deleteTree() is removed
+*
+* v.11 2026/10/18
+* - code lengths right from byte counts
+*
+* v.12 2026/10/18
+* - blocks coding could be chosen
+*
+* v.13 2026/10/18
+* - encodeCodeLengths() of any alphabet
+*
+* v.14 2026/10/18
+* - checkCodeLengthLimit() is public
+*
+* v.15 2026/10/18
+* - getFrequencyTable() is removed, blocks count their own bytes
+* - Huffman tree building is removed, nothing uses it
+*
+* v.16 2026/10/18
+* - compress() reports error if cypher file can't be written
+*
+* v.17 2026/10/18
+* - encodeCodeLengthsToFileHeader() is removed, single stream
+*   files are not written
+*
+* v.18 2026/10/18
+* - encodeMainTextToFile() of stream is removed, input is
+*   always in memory
+*
 * Implementation of the functions from HuffmanEncoding.h.
 *
 **********************************************************/
 
+#include <algorithm>
+#include <vector>
+#include "error.h"
 #include "HuffmanEncoding.h"
 #include "HuffmanTypes.h"
+#include "HuffmanHistogram.h"
+#include "mappedfile.h"
+#include "HuffmanBlocks.h"
 
 using namespace std;
 
@@ -34,275 +96,159 @@ string fileInput(string promptText) {
     return result;
 }
 
-/* Function: modifyMap
- * -------------------
- * Modifies param frequenciesMap entries
- * for current char key.
- */
-void modifyMap(MyMap<ext_char, int>& frequenciesMap,
-               ext_char nextSymbol) {
-    if (frequenciesMap.containsKey(nextSymbol)) {
-        /* Modifies map entry - increments symbol value */
-        int symbValue = frequenciesMap[nextSymbol];
-        frequenciesMap.put(nextSymbol, ++symbValue);
-    }else{
-        /* Adds new map entry for this symbol */
-        int symbApearence = 1;
-        frequenciesMap.put(nextSymbol, symbApearence);
-    }
-}
-
-/* Function: getFrequencyTable
- * Usage: MyMap<ext_char, int> freq = getFrequencyTable(file);
+/* Function: getCodeLengths
+ * Usage: CodeLengths lengths = getCodeLengths(counts, maxCodeLength);
  * --------------------------------------------------------
- * This function will also set the frequency of the EOF
- * character to be 1, which ensures that any future encoding
- * tree built from these frequencies will have an encoding for
- * the EOF character.
+ * PSEUDO_EOF gets weight 1, as it's coded once.
  */
-MyMap<ext_char, int> getFrequencyTable(ibstream& infileStream) {
-    MyMap<ext_char, int> resultFrequenciesMap;
-    ext_char nextChar;
-
-    while ((nextChar = infileStream.get()) != EOF) {
-        modifyMap(resultFrequenciesMap, nextChar);
-    }
-
-    resultFrequenciesMap.add(EOF, 1);
-    return resultFrequenciesMap;
+CodeLengths getCodeLengths(const long long* counts, int maxCodeLength) {
+    long long weights[CODE_TABLE_SIZE];
+    copy(counts, counts + BYTE_VALUES, weights);
+    weights[PSEUDO_EOF] = 1;
+    CodeLengths lengths = getWeightsCodeLengths(weights);
+    limitCodeLengths(lengths, maxCodeLength);
+    return lengths;
 }
 
-/* Function: buildNodesVector
- * Usage: buildNodesVector(vector, frequencyTable);
- * --------------------------------------------------------
- * Creates symbols Nodes from frequency table and adds them
- * to Nodes* queue
+/* Function: encodeCodeLengths
+ * ---------------------------
+ * Writes bit of presence for every symbol, and then 4-bit
+ * code length for every present symbol. Lengths are padded
+ * up to whole byte. Count of symbols isn't written, reader
+ * has to know it.
  */
-void loadQueueBySymbolsNodes(MyPQueue<Node*>& nodesQueue, MyMap<ext_char, int>& frequenciesMap){
-    for(ext_char key: frequenciesMap){
-        Node* symbNode = new Node;
-        /* Node constructor */
-        symbNode->symbol = key;
-        symbNode->symbAppearance = frequenciesMap[key];
-        symbNode->leftChild = NULL;
-        symbNode->rightChild = NULL;
-        /* Add curent node to queue whith apearence priority */
-        int symbAppearance = frequenciesMap[key];
-        nodesQueue.enqueue(symbNode, symbAppearance);
+void encodeCodeLengths(const CodeLengths& lengths, BitWriter& writer) {
+    int symbolCount = lengths.size();
+    /* Symbols presence bits */
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        writer.writeBit(lengths[symbol] > 0);
     }
-}
-
-/* Function: buildEncodingTree
- * Usage: Node* tree = buildEncodingTree(nodesVector);
- * --------------------------------------------------------
- * Constructs a Huffman encoding tree from frequencies Nodes
- * and returns a pointer to the root.
- */
-Node* buildEncodingTree(MyPQueue<Node*>& nodesQueue){
-    Node* root = new Node;//this root will return copy of tree root from function
-    while(!nodesQueue.isEmpty()){
-        Node* nd1 = nodesQueue.dequeueMin();//remove min appearence node form vec
-        if(!nodesQueue.isEmpty()){
-            Node* nd2 = nodesQueue.dequeueMin();
-            int sumAppear = nd1->symbAppearance + nd2->symbAppearance;
-            Node* parent = new Node;
-            parent->leftChild = nd1;
-            parent->rightChild = nd2;
-            parent->symbAppearance = sumAppear;
-            parent->symbol = NOT_A_CHAR;
-            nodesQueue.enqueue(parent, sumAppear);
-        }else{
-            root = nd1;
+    /* Lengths of present symbols */
+    for (int symbol = 0; symbol < symbolCount; symbol++) {
+        if (lengths[symbol] > 0) {
+            writer.writeBits(lengths[symbol], HEADER_LENGTH_BITS);
         }
     }
-    return root;
+    writer.alignToByte();
 }
 
-/* Function: deleteTree
- * Usage: deleteTree(encodingTreeRoot);
- * --------------------------------------------------------
- * Deallocates all memory allocated for a given encoding
- * tree.
+/* Function: encodeBytes
+ * ---------------------
+ * Writes codes of every byte of text.
  */
-void deleteTree(Node*& root) {
-    /* Fork end */
-    if (root->leftChild != NULL) {
-        deleteTree(root->leftChild);
-    }
-    if (root->rightChild != NULL) {
-        deleteTree(root->rightChild);
-    }
-    if ((root->leftChild == NULL) && (root->rightChild == NULL)) {
-        root = NULL;
-        delete root;
+static void encodeBytes(const unsigned char* text, size_t size,
+                        const CodeTable& codes, BitWriter& writer) {
+    for (size_t i = 0; i < size; i++) {
+        const SymbolCode& code = codes[text[i]];
+        writer.writeBits(code.bits, code.length);
     }
 }
 
-/* Function: encodeTreeToFileHeader
- * --------------------------------
- * Encodes tree shape into cypherFile.
- * Makes depth traversing of coding tree, and writes:
- *
- * - 0 - if it's knot at this traverse, without symbols
+/* Function: encodeMainTextToFile
+ * Usage: encodeMainTextToFile(text, size, lengths, writer);
+ * --------------------------------------------------------
+ * Encodes the given text using the canonical codes of the
+ * given code lengths. Codes are taken from flat CodeTable
+ * by byte value, and are written by BitWriter.
  *
- * - 1 - if it's leaf at this traverse, without childs.
- *   It is followed by char byte code.
+ * The code lengths were taken from the given text, so every
+ * character has its code. Text is ended by PSEUDO_EOF code.
  */
-void encodeTreeToFileHeader(Node* node, obstream& outfileStream) {
-    /* This node is fork end
-     * We should write '1' and char code then */
-    if ((node->leftChild == NULL) && (node->rightChild == NULL)) {
-        outfileStream.writeBit(1);
-        outfileStream.put((node->symbol));
-    }else{
-        /* This node has childs - we should write just '0' */
-        outfileStream.writeBit(0);
-        if (node->leftChild != NULL) {
-            encodeTreeToFileHeader((node->leftChild), outfileStream);
-        }
-        if (node->rightChild != NULL) {
-            encodeTreeToFileHeader((node->rightChild), outfileStream);
-        }
-    }
+void encodeMainTextToFile(const unsigned char* text, size_t size,
+                          const CodeLengths& lengths,
+                          BitWriter& writer) {
+    /* Cyphers table - [symb][Huffman code] */
+    CodeTable codes(lengths);
+    encodeBytes(text, size, codes, writer);
+
+    /* Write EOF */
+    const SymbolCode& eofCode = codes[PSEUDO_EOF];
+    writer.writeBits(eofCode.bits, eofCode.length);
 }
 
-/* Function: buildCypherTable
- * ---------------------------
- * Modifies param cypher table map
- * by entries [symbol][symbol Huffman code]
- * for this huffman tree.
- * Makes DFS from root to every symbol-leaf to
- * cocantenate currentCypher code value.
- *
- *
- * @param currentCypher        symbol
- * @param node                 root of Huffman tree
- * @param cypherTable          cypher table map to fill by entries
+/* Function: encodeInterleavedText
+ * ---------------------------------
+ * Part i is text from i * size / 4 to (i + 1) * size / 4.
+ * Jump table is patched after all streams are written.
  */
-void buildCodesTableForTree(string currentSymbolCode,
-                             Node* node,
-                             MyMap<ext_char, string>& charsCodesTable) {
-    /* This node is fork end */
-    if ((node->leftChild == NULL) && (node->rightChild == NULL)) {
-        charsCodesTable.add(node->symbol, currentSymbolCode);
-    }else{
-        /* This node has childs */
-        if (node->leftChild != NULL) {
-            string leftCypher = currentSymbolCode + "0";
-            buildCodesTableForTree(leftCypher, node->leftChild, charsCodesTable);
+void encodeInterleavedText(const unsigned char* text, size_t size,
+                           const CodeLengths& lengths, vector<char>& data) {
+    CodeTable codes(lengths);
+    size_t jumpTable = data.size();
+    data.resize(jumpTable + INTERLEAVED_JUMP_TABLE_SIZE, 0);
+    for (int i = 0; i < INTERLEAVED_STREAMS; i++) {
+        size_t partStart = size * i / INTERLEAVED_STREAMS;
+        size_t partEnd = size * (i + 1) / INTERLEAVED_STREAMS;
+        size_t streamStart = data.size();
+        {
+            BitWriter writer(data);
+            encodeBytes(text + partStart, partEnd - partStart, codes, writer);
         }
-        if (node->rightChild != NULL) {
-            string rightCypher = currentSymbolCode + "1";
-            buildCodesTableForTree(rightCypher, node->rightChild, charsCodesTable);
+        if (i == INTERLEAVED_STREAMS - 1) break;
+        size_t streamSize = data.size() - streamStart;
+        for (int j = 0; j < 4; j++) {
+            data[jumpTable + 4 * i + j] = (char) (streamSize >> (8 * j));
         }
     }
 }
 
-/* Function: writeCodeToStream
- * ---------------------------
- * Writes this symbol code to output stream
- *
- * @param symbCode   stores string of bit-code for some symbol
- */
-void writeCodeToStream(string symbolCode, obstream& outfileStream) {
-    for (int i = 0; i < symbolCode.length(); i++) {
-        if (symbolCode[i] == '1') {
-            outfileStream.writeBit(1);
-        }else{
-            outfileStream.writeBit(0);
-        }
+void checkCodeLengthLimit(string functionName, int maxCodeLength) {
+    if ((maxCodeLength < MIN_CODE_LENGTH_LIMIT) || (maxCodeLength > MAX_CODE_LENGTH)) {
+        error(functionName + ": Code length limit has to be from "
+              + integerToString(MIN_CODE_LENGTH_LIMIT) + " to "
+              + integerToString(MAX_CODE_LENGTH));
     }
 }
 
-/* Function: getCodeForChar
- * ---------------------------
- * Returns corresponding code for param char
- */
-string getCodeForChar(char currentTextChar,
-                    MyMap<ext_char, string>& charsCodesTable){
-    return charsCodesTable[(ext_char)currentTextChar];
-}
-
-/* Function: encodeMainTextToFile
- * Usage: encodeMainTextToFile(sourceFile, encodingTree, cypheredFile);
- * --------------------------------------------------------
- * Encodes the given file using the encoding specified by the
- * given encoding tree, then writes the result one bit at a
- * time to the specified output file.
- *
- * This function can assume the following:
- *
- *   - The encoding tree was constructed from the given file,
- *     so every character appears somewhere in the encoding
- *     tree.
- *
- *   - The output file already has the encoding table written
- *     to it, and the file cursor is at the end of the file.
- *     This means that you should just start writing the bits
- *     without seeking the file anywhere.
- */
-void encodeMainTextToFile(ibstream& infileStream,
-                          Node* root,
-                          obstream& outfileStream) {
-    /* Cyphers table - [symb][Huffman code] */
-    MyMap<ext_char, string> charsCodesTable;
-    string currentCypher = "";//start code to concantenate
-    /* Fills cypherTable by entries [symb][Huffman code] */
-    buildCodesTableForTree(currentCypher, root, charsCodesTable);
-
-    /* Infile stream translation process  */
-    char textChar;
-    string symbCode = "";
-    while ((textChar = infileStream.get()) != EOF) {
-        symbCode = getCodeForChar(textChar, charsCodesTable);
-        writeCodeToStream(symbCode, outfileStream);
-    }
-
-    /* Write EOF */
-    symbCode = getCodeForChar(EOF, charsCodesTable);
-    writeCodeToStream(symbCode, outfileStream);//Main EOF
-    writeCodeToStream(symbCode, outfileStream);//Fix problem of EOF decoding
-}
-
 /* Function: compress
  * Usage: compress(inputFile, cypherFile);
  * --------------------------------------------------------
  * Main entry point for the Huffman compressor.  Compresses
  * the inputFile, then writes the result to cypherFile.
+ *
+ * Input file is mapped into memory (or read by single call),
+ * and is written as block container, whose blocks are coded
+ * by threadCount threads.
  */
-void compress(string inputFile, string cypherFile) {
+void compress(string inputFile, string cypherFile, int maxCodeLength, int threadCount,
+              BlockCoding coding) {
+    checkCodeLengthLimit("compress", maxCodeLength);
     cout << "PROCESSING..." << endl;
     cout << "==========================================================" << endl;
     /* Huffman compression process */
     cout << "    - WAIT, FILE \"" << inputFile << "\" IS BEING CODED..." << endl;
-    /* Prepare input stream object   */
-    ifbstream infileStream;
-    infileStream.open(inputFile.c_str());
+    /* Prepare input bytes and output stream */
+    MappedFile input(inputFile);
+    if (!input.isOpen()) {
+        error("compress: Can't read file \"" + inputFile + "\"");
+    }
     ofbstream outfileStream;
     outfileStream.open(cypherFile.c_str());
+    if (!outfileStream.is_open()) {
+        error("compress: Can't write file \"" + cypherFile + "\"");
+    }
 
-    /* Input file compression */
-    /* Calculates the frequencies of each character within text */
-    MyMap<ext_char, int> frequenciesTable = getFrequencyTable(infileStream);
-
-    /* Priority queue for cypher tree creation */
-    MyPQueue<Node*> nodesQueue;
-    /* Creates nodes for each symbol and put them to queue */
-    loadQueueBySymbolsNodes(nodesQueue, frequenciesTable);
-    /* Main Huffman tree building */
-    Node* root = buildEncodingTree(nodesQueue);
-    /* ENCODE TREE INTO CYPHER FILE HEADER */
-    encodeTreeToFileHeader(root, outfileStream);
-    outfileStream.put(' ');//put some char to divide header from main text cypher cypher
-
-    /* ENCODE FILE MAIN TEXT INTO CYPHER FILE */
-    infileStream.rewind();
-    encodeMainTextToFile(infileStream, root, outfileStream);
-
-    /* Memory cleaning */
-    deleteTree(root);
+    /* Input file compression by blocks */
+    ThreadPool pool(threadCount);
+    compressBlocks(input.data(), input.size(), outfileStream, maxCodeLength, pool,
+                   BLOCK_SIZE, coding);
 
-    infileStream.close();
     outfileStream.close();
+    if (outfileStream.fail()) {
+        error("compress: Can't write file \"" + cypherFile + "\"");
+    }
     cout << "    - FILE'S CODING COMPLETE!" << endl;
 }
+
+/* Function: compressStream
+ * Usage: compressStream(cin, cout);
+ * ---------------------------------
+ * Stream is read once by windows, so it's not rewinded
+ * and could be a pipe. Nothing is printed to cout.
+ */
+void compressStream(istream& in, ostream& out, int maxCodeLength, int threadCount,
+                    BlockCoding coding) {
+    checkCodeLengthLimit("compressStream", maxCodeLength);
+    ThreadPool pool(threadCount);
+    compressBlocksStream(in, out, maxCodeLength, pool, BLOCK_SIZE, coding);
+}
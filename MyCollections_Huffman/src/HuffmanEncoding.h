@@ -6,6 +6,44 @@
 * - code formatted
 * - code fields renamed
 *
+* v.3 2026/10/18
+* - header keeps code lengths of canonical codes
+* - compress() has code length limit param
+*
+* v.4 2026/10/18
+* - in-memory versions of the both compression passes
+*
+* v.5 2026/10/18
+* - compress() writes block container
+*
+* v.6 2026/10/18
+* - compressStream() is added
+*
+* v.7 2026/10/18
+* - encodeInterleavedText() is added
+*
+* v.8 2026/10/18
+* - tree is HuffmanTree array, deleteTree() is removed
+*
+* v.9 2026/10/18
+* - getCodeLengths() from byte counts, without tree
+*
+* v.10 2026/10/18
+* - compress(), compressStream() have blocks coding param
+*
+* v.11 2026/10/18
+* - checkCodeLengthLimit() is public
+*
+* v.12 2026/10/18
+* - getFrequencyTable(), frequenciesFromCounts() are removed
+* - tree building functions are removed, lengths come from counts
+*
+* v.13 2026/10/18
+* - encodeCodeLengthsToFileHeader() is removed
+*
+* v.14 2026/10/18
+* - encodeMainTextToFile() of stream is removed
+*
 * Definitions for the functions necessary to build a
 * Huffman encoding system.
 *******************************************************/
@@ -23,10 +61,11 @@
 #include "console.h"
 #include "strlib.h"
 #include "bstream.h"
+#include "bitio.h"
 #include "HuffmanEncoding.h"
 #include "HuffmanTypes.h"
-#include "myPQueue.h"
-#include "myMap.h"
+#include "HuffmanCodes.h"
+#include "HuffmanBlocks.h"
 
 
 /* Function: fileInput
@@ -35,63 +74,79 @@
  */
 string fileInput(string promptText);
 
-/* Function: getFrequencyTable
- * Usage: MyMap<ext_char, int> freq = getFrequencyTable(file);
+/* Function: getCodeLengths
+ * Usage: CodeLengths lengths = getCodeLengths(counts, maxCodeLength);
  * --------------------------------------------------------
- * Calculates the frequencies of each character within
- * infileStream text and stores
- * the result as a MyMap from ext_chars to the number of times
- * that the character appears.
+ * Returns code lengths of BYTE_VALUES byte counts and
+ * PSEUDO_EOF, which are limited by maxCodeLength. Lengths
+ * are found in linear time after one sort of counts, and
+ * no tree is built.
  */
-MyMap<ext_char, int> getFrequencyTable(ibstream &infileStream);
+CodeLengths getCodeLengths(const long long* counts, int maxCodeLength);
 
-/* Function: loadQueueBySymbolsNodes
- * --------------------------------------------------------
- * Creates symbols Nodes from frequency table and adds them
- * to Nodes* queue
+/* Function: encodeCodeLengths
+ * ---------------------------
+ * Writes code lengths of present symbols: presence bit of
+ * every symbol, and then 4-bit length of present ones, as
+ * every block of block container has.
  */
-void loadQueueBySymbolsNodes(MyPQueue<Node*>& mpq, MyMap<ext_char, int> &frequenciesMap);
+void encodeCodeLengths(const CodeLengths &lengths, BitWriter &writer);
 
-/* Function: buildEncodingTree
- * Usage: Node* tree = buildEncodingTree(nodesQueue);
+/* Function: encodeInterleavedText
+ * Usage: encodeInterleavedText(text, size, lengths, data);
  * --------------------------------------------------------
- * Constructs a Huffman encoding tree from frequencies Nodes
- * and returns a pointer to the root.
+ * Splits text into INTERLEAVED_STREAMS equal parts, and
+ * appends to data jump table and codes of every part as
+ * separate stream, padded to byte. Parts have no PSEUDO_EOF,
+ * their sizes are taken from the text size.
  */
-Node* buildEncodingTree(MyPQueue<Node *> &nodesQueue);
+void encodeInterleavedText(const unsigned char* text, size_t size,
+                           const CodeLengths &lengths, std::vector<char> &data);
 
-/* Function: deleteTree
- * Usage: deleteTree(encodingTree);
- * --------------------------------
- * Deallocates all memory allocated for a given encoding
- * tree.
- */
-void deleteTree(Node* &root);
-
-/* Function: encodeTreeToFileHeader
- * --------------------------------
- * Encodes tree shape into cypherFile.
- * Makes depth traversing of coding tree, and writes:
+/* Function: encodeMainTextToFile
+ * Usage: encodeMainTextToFile(text, size, lengths, writer);
+ * --------------------------------------------------------
+ * Encodes size bytes of text in memory by writer, and ends
+ * them by PSEUDO_EOF code.
  */
-void encodeTreeToFileHeader(Node* node, obstream &outfileStream);
+void encodeMainTextToFile(const unsigned char* text, size_t size,
+                          const CodeLengths &lengths, BitWriter &writer);
 
-/* Function: encodeMainTextToFile
- * Usage: encodeMainTextToFile(sourceFileStream,
- *                             encodingTree,
- *                             cypheredFileStream);
+/* Function: checkCodeLengthLimit
+ * Usage: checkCodeLengthLimit("compress", maxCodeLength);
  * --------------------------------------------------------
- * Encodes chars from  infileStream file text to outfileStream
- * file.
+ * Reports error if code length limit is out of range.
  */
-void encodeMainTextToFile(ibstream &infileStream, Node* encodingTree, obstream &outfileStream);
+void checkCodeLengthLimit(string functionName, int maxCodeLength);
 
 /* Function: compress
  * Usage: compress(inputFile, cypherFile);
+ *        compress(inputFile, cypherFile, maxCodeLength);
  * --------------------------------------------------------
  * Main entry point for the Huffman compressor.  Compresses
  * the inputFile, then writes the result to cypherFile.
+ * Codes are not longer then maxCodeLength, which has to be
+ * from MIN_CODE_LENGTH_LIMIT to MAX_CODE_LENGTH.
+ *
+ * Text is split into blocks, which are coded by threadCount
+ * threads (0 - by all hardware threads), see HuffmanBlocks.h.
+ * RANS_BLOCKS coding replaces Huffman codes by rANS coder,
+ * and maxCodeLength isn't used then.
+ */
+void compress(string inputFile, string cypherFile,
+              int maxCodeLength = MAX_CODE_LENGTH, int threadCount = 0,
+              BlockCoding coding = INTERLEAVED_BLOCKS);
+
+/* Function: compressStream
+ * Usage: compressStream(cin, cout);
+ * --------------------------------------------------------
+ * Compresses in stream up to its end into out, with bounded
+ * memory - in is read by windows of few blocks. Result is
+ * the same block container as compress() writes.
  */
-void compress(string inputFile, string cypherFile);
+void compressStream(istream& in, ostream& out,
+                    int maxCodeLength = MAX_CODE_LENGTH, int threadCount = 0,
+                    BlockCoding coding = INTERLEAVED_BLOCKS);
 
 
 #endif
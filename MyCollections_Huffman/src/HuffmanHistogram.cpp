@@ -0,0 +1,84 @@
+/**********************************************************
+* File: HuffmanHistogram.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - histogramBits()
+*
+* v.3 2026/10/18
+* - countBytesParallel(), countStreamBytes() are removed
+*
+* Implementation of the functions from HuffmanHistogram.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "HuffmanHistogram.h"
+
+using namespace std;
+
+/* Constant: TABLES_PART_SIZE
+ * Tables have 32-bit counters, so they are summed into
+ * result after every part of such size.
+ */
+static const size_t TABLES_PART_SIZE = 1 << 30;
+
+/* Function: countPart
+ * -------------------
+ * Counts part of buffer into interleaved tables. Bytes are
+ * loaded by 8-byte words, and every byte of word goes to
+ * table of its position.
+ */
+static void countPart(const unsigned char* data, size_t size,
+                      unsigned tables[HISTOGRAM_TABLES][BYTE_VALUES]) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        unsigned long long word;
+        memcpy(&word, data + i, 8);
+        tables[0][word & 0xFF]++;
+        tables[1][(word >> 8) & 0xFF]++;
+        tables[2][(word >> 16) & 0xFF]++;
+        tables[3][(word >> 24) & 0xFF]++;
+        tables[0][(word >> 32) & 0xFF]++;
+        tables[1][(word >> 40) & 0xFF]++;
+        tables[2][(word >> 48) & 0xFF]++;
+        tables[3][word >> 56]++;
+    }
+    /* Buffer tail */
+    for (; i < size; i++) {
+        tables[0][data[i]]++;
+    }
+}
+
+void countBytes(const unsigned char* data, size_t size, long long* counts) {
+    unsigned tables[HISTOGRAM_TABLES][BYTE_VALUES];
+    while (size > 0) {
+        size_t partSize = min(size, TABLES_PART_SIZE);
+        memset(tables, 0, sizeof(tables));
+        countPart(data, partSize, tables);
+        for (int value = 0; value < BYTE_VALUES; value++) {
+            for (int table = 0; table < HISTOGRAM_TABLES; table++) {
+                counts[value] += tables[table][value];
+            }
+        }
+        data += partSize;
+        size -= partSize;
+    }
+}
+
+double histogramBits(const long long* counts) {
+    long long total = 0;
+    for (int value = 0; value < BYTE_VALUES; value++) {
+        total += counts[value];
+    }
+    double bits = 0;
+    for (int value = 0; value < BYTE_VALUES; value++) {
+        if (counts[value] > 0) {
+            bits += counts[value] * log2((double) total / counts[value]);
+        }
+    }
+    return bits;
+}
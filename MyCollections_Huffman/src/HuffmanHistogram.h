@@ -0,0 +1,54 @@
+/*******************************************************
+* File: HuffmanHistogram.h
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - histogramBits() estimate of coded size
+*
+* v.3 2026/10/18
+* - threaded and stream counting are removed, every block
+*   is counted by its own coding thread
+*
+* Byte histogram kernels for the first pass of Huffman
+* compression. Bytes are counted over big in-memory
+* buffers, instead of map update for every byte.
+*******************************************************/
+
+#ifndef HuffmanHistogram_Included
+#define HuffmanHistogram_Included
+
+#include <cstddef>
+
+/* Constant: BYTE_VALUES
+ * Count of cells of every byte histogram.
+ */
+const int BYTE_VALUES = 256;
+
+/* Constant: HISTOGRAM_TABLES
+ * Count of interleaved count tables of single thread kernel.
+ * Neighbour bytes go to different tables, so equal bytes in
+ * a row don't wait for each other's counter store.
+ */
+const int HISTOGRAM_TABLES = 4;
+
+/* Function: countBytes
+ * Usage: countBytes(data, size, counts);
+ * --------------------------------------
+ * Adds count of every byte value of data buffer into
+ * counts, which has BYTE_VALUES cells. Runs in current
+ * thread, with HISTOGRAM_TABLES interleaved tables.
+ */
+void countBytes(const unsigned char* data, size_t size, long long* counts);
+
+/* Function: histogramBits
+ * Usage: double bits = histogramBits(counts);
+ * -------------------------------------------
+ * Returns count of bits of the shortest coding of bytes
+ * with such BYTE_VALUES counts by one code table (entropy
+ * of histogram by its total). Huffman codes take a bit
+ * more, so it's fast estimate of coded size.
+ */
+double histogramBits(const long long* counts);
+
+#endif
@@ -0,0 +1,324 @@
+/**********************************************************
+* File: HuffmanLz77.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* Implementation of the functions from HuffmanLz77.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include "HuffmanLz77.h"
+#include "HuffmanCodes.h"
+#include "HuffmanEncoding.h"
+#include "HuffmanDecoding.h"
+#include "bitio.h"
+
+using namespace std;
+
+/* Constants: LENGTH_BASES, LENGTH_EXTRA_BITS
+ * The shortest match length of every length symbol after
+ * LZ77_END, and count of extra bits, which are added to it.
+ */
+static const int LENGTH_SYMBOLS = LZ77_LITLEN_SYMBOLS - LZ77_END - 1;
+static const int LENGTH_BASES[LENGTH_SYMBOLS] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const int LENGTH_EXTRA_BITS[LENGTH_SYMBOLS] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/* Constants: DISTANCE_BASES, DISTANCE_EXTRA_BITS
+ * The same for distance symbols.
+ */
+static const int DISTANCE_BASES[LZ77_DISTANCE_SYMBOLS] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+static const int DISTANCE_EXTRA_BITS[LZ77_DISTANCE_SYMBOLS] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Constants: LZ77_HASH_BITS, LZ77_NICE_MATCH
+ * Size of hash table of 3 byte strings, and match length,
+ * after which next position isn't tried for longer match.
+ */
+static const int LZ77_HASH_BITS = 15;
+static const int LZ77_NICE_MATCH = 32;
+
+/* Type: SymbolTables
+ * Symbol index of every match length, and of every distance:
+ * distances up to 256 by (distance - 1), longer ones by
+ * 256 + ((distance - 1) >> 7), as all their symbols have
+ * 7 extra bits at least.
+ */
+struct SymbolTables {
+    unsigned char lengthSymbols[LZ77_MAX_MATCH + 1];
+    unsigned char distanceSymbols[512];
+
+    SymbolTables() {
+        for (int symbol = 0; symbol < LENGTH_SYMBOLS; symbol++) {
+            int count = 1 << LENGTH_EXTRA_BITS[symbol];
+            for (int i = 0; (i < count) && (LENGTH_BASES[symbol] + i <= LZ77_MAX_MATCH); i++) {
+                lengthSymbols[LENGTH_BASES[symbol] + i] = symbol;
+            }
+        }
+        /* 258 has own symbol, not the last one of 227 + 31 */
+        lengthSymbols[LZ77_MAX_MATCH] = LENGTH_SYMBOLS - 1;
+        for (int symbol = 0; symbol < LZ77_DISTANCE_SYMBOLS; symbol++) {
+            int count = 1 << DISTANCE_EXTRA_BITS[symbol];
+            for (int i = 0; i < count; i++) {
+                int distance = DISTANCE_BASES[symbol] + i - 1;
+                int index = (distance < 256) ? distance : 256 + (distance >> 7);
+                distanceSymbols[index] = symbol;
+            }
+        }
+    }
+
+    int distanceSymbol(int distance) const {
+        distance--;
+        return distanceSymbols[(distance < 256) ? distance : 256 + (distance >> 7)];
+    }
+};
+
+/* Function: symbolTables
+ * ----------------------
+ * Tables are built once, at the first call.
+ */
+static const SymbolTables& symbolTables() {
+    static const SymbolTables tables;
+    return tables;
+}
+
+/* Type: LzToken
+ * Literal byte (length 0), or match of length and distance.
+ */
+struct LzToken {
+    unsigned short length;
+    unsigned short value;
+};
+
+/*
+ * Class: MatchFinder
+ * ------------------
+ * Hash chains of 3 byte strings: head keeps the last position
+ * of every hash, prev keeps previous position of the same hash
+ * for every position of the window.
+ */
+class MatchFinder {
+public:
+    MatchFinder(const unsigned char* text, size_t size)
+        : text(text), size(size),
+          head(1 << LZ77_HASH_BITS, -1), prev(LZ77_WINDOW_SIZE, -1) {
+    }
+
+    void insert(size_t pos) {
+        if (pos + LZ77_MIN_MATCH > size) return;
+        int& last = head[hash(pos)];
+        prev[pos & (LZ77_WINDOW_SIZE - 1)] = last;
+        last = (int) pos;
+    }
+
+    /* Returns the longest match length at pos, or 0 */
+    int find(size_t pos, int& distance) const {
+        if (pos + LZ77_MIN_MATCH > size) return 0;
+        int limit = (int) min((size_t) LZ77_MAX_MATCH, size - pos);
+        int best = LZ77_MIN_MATCH - 1;
+        const unsigned char* current = text + pos;
+        int candidate = head[hash(pos)];
+        for (int chain = 0; (chain < LZ77_MAX_CHAIN) && (candidate >= 0); chain++) {
+            if (pos - candidate > (size_t) LZ77_WINDOW_SIZE) break;
+            const unsigned char* earlier = text + candidate;
+            if (earlier[best] == current[best]) {
+                int length = 0;
+                while ((length < limit) && (earlier[length] == current[length])) {
+                    length++;
+                }
+                if (length > best) {
+                    best = length;
+                    distance = (int) (pos - candidate);
+                    if (best == limit) break;
+                }
+            }
+            int next = prev[candidate & (LZ77_WINDOW_SIZE - 1)];
+            if (next >= candidate) break;
+            candidate = next;
+        }
+        return (best >= LZ77_MIN_MATCH) ? best : 0;
+    }
+
+private:
+    const unsigned char* text;
+    size_t size;
+    vector<int> head;
+    vector<int> prev;
+
+    unsigned hash(size_t pos) const {
+        unsigned key = (text[pos] << 16) | (text[pos + 1] << 8) | text[pos + 2];
+        return (key * 2654435761u) >> (32 - LZ77_HASH_BITS);
+    }
+};
+
+/* Function: findTokens
+ * --------------------
+ * Greedy parsing with one step lazy matching: if the next
+ * position has longer match, current byte goes as literal.
+ */
+static void findTokens(const unsigned char* text, size_t size, vector<LzToken>& tokens) {
+    MatchFinder finder(text, size);
+    size_t pos = 0;
+    int length = 0;
+    int distance = 0;
+    bool haveMatch = false;
+    while (pos < size) {
+        if (!haveMatch) {
+            length = finder.find(pos, distance);
+        }
+        haveMatch = false;
+        finder.insert(pos);
+        if (length == 0) {
+            LzToken literal = {0, text[pos]};
+            tokens.push_back(literal);
+            pos++;
+            continue;
+        }
+
+        int nextDistance = 0;
+        int nextLength = (length < LZ77_NICE_MATCH) ? finder.find(pos + 1, nextDistance) : 0;
+        if (nextLength > length) {
+            LzToken literal = {0, text[pos]};
+            tokens.push_back(literal);
+            pos++;
+            length = nextLength;
+            distance = nextDistance;
+            haveMatch = true;
+            continue;
+        }
+
+        LzToken match = {(unsigned short) length, (unsigned short) distance};
+        tokens.push_back(match);
+        for (int i = 1; i < length; i++) {
+            finder.insert(pos + i);
+        }
+        pos += length;
+    }
+}
+
+/* Function: encodeLz77Block
+ * -------------------------
+ * Tokens are counted for both alphabets, and code lengths
+ * are found by the same linear time builder as byte codes.
+ */
+void encodeLz77Block(const unsigned char* text, size_t size,
+                     int maxCodeLength, vector<char>& data) {
+    const SymbolTables& tables = symbolTables();
+    vector<LzToken> tokens;
+    tokens.reserve(size / 2 + 1);
+    findTokens(text, size, tokens);
+
+    long long litlenCounts[LZ77_LITLEN_SYMBOLS] = {0};
+    long long distanceCounts[LZ77_DISTANCE_SYMBOLS] = {0};
+    for (const LzToken& token : tokens) {
+        if (token.length == 0) {
+            litlenCounts[token.value]++;
+        } else {
+            litlenCounts[LZ77_END + 1 + tables.lengthSymbols[token.length]]++;
+            distanceCounts[tables.distanceSymbol(token.value)]++;
+        }
+    }
+    litlenCounts[LZ77_END] = 1;
+
+    CodeLengths litlenLengths = getWeightsCodeLengths(litlenCounts, LZ77_LITLEN_SYMBOLS);
+    limitCodeLengths(litlenLengths, maxCodeLength);
+    CodeLengths distanceLengths = getWeightsCodeLengths(distanceCounts, LZ77_DISTANCE_SYMBOLS);
+    limitCodeLengths(distanceLengths, maxCodeLength);
+    CodeTable litlenCodes(litlenLengths);
+    CodeTable distanceCodes(distanceLengths);
+
+    BitWriter writer(data);
+    encodeCodeLengths(litlenLengths, writer);
+    encodeCodeLengths(distanceLengths, writer);
+    for (const LzToken& token : tokens) {
+        if (token.length == 0) {
+            const SymbolCode& code = litlenCodes[token.value];
+            writer.writeBits(code.bits, code.length);
+            continue;
+        }
+        int lengthSymbol = tables.lengthSymbols[token.length];
+        const SymbolCode& lengthCode = litlenCodes[LZ77_END + 1 + lengthSymbol];
+        writer.writeBits(lengthCode.bits, lengthCode.length);
+        writer.writeBits(token.length - LENGTH_BASES[lengthSymbol], LENGTH_EXTRA_BITS[lengthSymbol]);
+
+        int distanceSymbol = tables.distanceSymbol(token.value);
+        const SymbolCode& distanceCode = distanceCodes[distanceSymbol];
+        writer.writeBits(distanceCode.bits, distanceCode.length);
+        writer.writeBits(token.value - DISTANCE_BASES[distanceSymbol],
+                         DISTANCE_EXTRA_BITS[distanceSymbol]);
+    }
+    const SymbolCode& endCode = litlenCodes[LZ77_END];
+    writer.writeBits(endCode.bits, endCode.length);
+}
+
+/* Function: decodeLz77Block
+ * -------------------------
+ * One refill gives 57 bits, and the longest match takes
+ * 15 + 5 + 15 + 13 bits, so every token is decoded by one
+ * refill. Matches are copied by bytes, as they could
+ * overlap their own bytes.
+ */
+bool decodeLz77Block(const char* data, size_t dataSize, char* text, size_t textSize) {
+    BitReader reader(data, dataSize);
+    CodeLengths litlenLengths;
+    CodeLengths distanceLengths;
+    if (!readCodeLengths(reader, litlenLengths, LZ77_LITLEN_SYMBOLS)
+            || !readCodeLengths(reader, distanceLengths, LZ77_DISTANCE_SYMBOLS)) {
+        return false;
+    }
+    DecodeTable litlenTable(litlenLengths);
+    DecodeTable distanceTable(distanceLengths);
+
+    size_t pos = 0;
+    while (true) {
+        reader.refill();
+        ext_char symbol;
+        int codeLength = litlenTable.decode(reader.peek(), reader.available(), symbol);
+        if (codeLength == 0) return false;
+        reader.consume(codeLength);
+
+        if (symbol < LZ77_END) {
+            if (pos == textSize) return false;
+            text[pos++] = (char) symbol;
+            continue;
+        }
+        if (symbol == LZ77_END) {
+            return pos == textSize;
+        }
+
+        int lengthSymbol = symbol - LZ77_END - 1;
+        int extraBits = LENGTH_EXTRA_BITS[lengthSymbol];
+        if (reader.available() < extraBits) return false;
+        int length = LENGTH_BASES[lengthSymbol] + (int) (reader.peek() & ((1u << extraBits) - 1));
+        reader.consume(extraBits);
+
+        ext_char distanceSymbol;
+        codeLength = distanceTable.decode(reader.peek(), reader.available(), distanceSymbol);
+        if (codeLength == 0) return false;
+        reader.consume(codeLength);
+        extraBits = DISTANCE_EXTRA_BITS[distanceSymbol];
+        if (reader.available() < extraBits) return false;
+        size_t distance = DISTANCE_BASES[distanceSymbol] + (reader.peek() & ((1u << extraBits) - 1));
+        reader.consume(extraBits);
+
+        if ((distance > pos) || ((size_t) length > textSize - pos)) return false;
+        char* target = text + pos;
+        const char* source = target - distance;
+        for (int i = 0; i < length; i++) {
+            target[i] = source[i];
+        }
+        pos += length;
+    }
+}
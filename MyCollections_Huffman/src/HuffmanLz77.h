@@ -0,0 +1,69 @@
+/*******************************************************
+* File: HuffmanLz77.h
+* --------------------------
+* v.1 2026/10/18
+*
+* LZ77 stage before Huffman coding, in deflate style.
+* Repeated strings of block are replaced by (length, distance)
+* matches to previous bytes of LZ77_WINDOW_SIZE window, and
+* then literals, match lengths and distances are coded by
+* canonical Huffman codes of two alphabets.
+*
+* Block data format:
+* - code lengths of LZ77_LITLEN_SYMBOLS literal/length symbols
+*   (see encodeCodeLengths): 0..255 - literal bytes,
+*   LZ77_END - end of block, next ones - match lengths;
+* - code lengths of LZ77_DISTANCE_SYMBOLS distance symbols;
+* - codes of literals and matches: match is length code,
+*   its extra bits, distance code and its extra bits;
+* - LZ77_END code, zero bits up to the next byte.
+* Length and distance symbols with extra bits are the same
+* as in deflate (RFC 1951).
+*******************************************************/
+
+#ifndef HuffmanLz77_Included
+#define HuffmanLz77_Included
+
+#include <cstddef>
+#include <vector>
+#include "HuffmanTypes.h"
+
+/* Constants: LZ77_WINDOW_SIZE, LZ77_MIN_MATCH, LZ77_MAX_MATCH
+ * The farthest distance of match, and the shortest and the
+ * longest match lengths.
+ */
+const int LZ77_WINDOW_SIZE = 1 << 15;
+const int LZ77_MIN_MATCH = 3;
+const int LZ77_MAX_MATCH = 258;
+
+/* Constant: LZ77_MAX_CHAIN
+ * Count of previous positions with the same hash, which
+ * are tried for every match.
+ */
+const int LZ77_MAX_CHAIN = 64;
+
+/* Constants: LZ77_END, LZ77_LITLEN_SYMBOLS, LZ77_DISTANCE_SYMBOLS
+ * End of block symbol and sizes of both alphabets.
+ */
+const int LZ77_END = PSEUDO_EOF;
+const int LZ77_LITLEN_SYMBOLS = LZ77_END + 30;
+const int LZ77_DISTANCE_SYMBOLS = 30;
+
+/* Function: encodeLz77Block
+ * Usage: encodeLz77Block(text, size, maxCodeLength, data);
+ * --------------------------------------------------------
+ * Finds matches of text block, and appends code lengths and
+ * codes of literals and matches to data vector.
+ */
+void encodeLz77Block(const unsigned char* text, size_t size,
+                     int maxCodeLength, std::vector<char>& data);
+
+/* Function: decodeLz77Block
+ * Usage: if (decodeLz77Block(data, dataSize, text, textSize)) ...
+ * ---------------------------------------------------------------
+ * Decodes textSize bytes from block data. Returns false if
+ * data is broken.
+ */
+bool decodeLz77Block(const char* data, size_t dataSize, char* text, size_t textSize);
+
+#endif
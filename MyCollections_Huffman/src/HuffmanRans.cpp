@@ -0,0 +1,223 @@
+/**********************************************************
+* File: HuffmanRans.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* Implementation of the functions from HuffmanRans.h.
+*
+**********************************************************/
+
+#include "HuffmanRans.h"
+#include "HuffmanHistogram.h"
+#include "bitio.h"
+
+using namespace std;
+
+/* Constants: RANS_SCALE, RANS_MASK
+ * Sum of normalized frequencies, and mask of state slot.
+ */
+static const unsigned RANS_SCALE = 1u << RANS_SCALE_BITS;
+static const unsigned RANS_MASK = RANS_SCALE - 1;
+
+/* Constant: RANS_STATE_SIZE
+ * Count of bytes of every flushed state.
+ */
+static const int RANS_STATE_SIZE = 4;
+
+/* Function: normalizeFrequencies
+ * ------------------------------
+ * Frequencies are scaled down, rare bytes get 1, and then
+ * the sum is fixed: the most frequent byte gets the lack,
+ * or the biggest frequencies give 1 by turns.
+ */
+void normalizeFrequencies(const long long* counts, int* frequencies) {
+    unsigned long long total = 0;
+    for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+        total += counts[symbol];
+    }
+    int sum = 0;
+    int mostFrequent = 0;
+    for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+        frequencies[symbol] = 0;
+        if (counts[symbol] == 0) continue;
+        unsigned long long scaled = ((unsigned long long) counts[symbol] * RANS_SCALE + total / 2) / total;
+        frequencies[symbol] = (scaled > 0) ? (int) scaled : 1;
+        sum += frequencies[symbol];
+        if (counts[symbol] > counts[mostFrequent]) {
+            mostFrequent = symbol;
+        }
+    }
+    if (sum == 0) return;
+
+    if (sum < (int) RANS_SCALE) {
+        frequencies[mostFrequent] += RANS_SCALE - sum;
+    }
+    while (sum > (int) RANS_SCALE) {
+        int biggest = 0;
+        for (int symbol = 1; symbol < BYTE_VALUES; symbol++) {
+            if (frequencies[symbol] > frequencies[biggest]) {
+                biggest = symbol;
+            }
+        }
+        frequencies[biggest]--;
+        sum--;
+    }
+}
+
+/* Type: RansSymbol
+ * Frequency of symbol and start of its slots.
+ */
+struct RansSymbol {
+    unsigned frequency;
+    unsigned start;
+};
+
+/* Function: buildSymbols
+ * ----------------------
+ * Gives every symbol consecutive slots of its frequency.
+ */
+static void buildSymbols(const int* frequencies, RansSymbol* symbols) {
+    unsigned start = 0;
+    for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+        symbols[symbol].frequency = frequencies[symbol];
+        symbols[symbol].start = start;
+        start += frequencies[symbol];
+    }
+}
+
+/* Function: encodeRansBlock
+ * -------------------------
+ * rANS is LIFO coder, so text is coded from its end, and
+ * stream bytes are written from the end of the buffer. Then
+ * decoder reads both text and stream forward. At most
+ * RANS_SCALE_BITS bits are written for every symbol.
+ */
+void encodeRansBlock(const unsigned char* text, size_t size, vector<char>& data) {
+    long long counts[BYTE_VALUES] = {0};
+    countBytes(text, size, counts);
+    int frequencies[BYTE_VALUES];
+    normalizeFrequencies(counts, frequencies);
+
+    /* Frequencies header */
+    {
+        BitWriter writer(data);
+        for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+            writer.writeBit(frequencies[symbol] > 0);
+        }
+        for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+            if (frequencies[symbol] > 0) {
+                writer.writeBits(frequencies[symbol] - 1, RANS_SCALE_BITS);
+            }
+        }
+    }
+
+    RansSymbol symbols[BYTE_VALUES];
+    buildSymbols(frequencies, symbols);
+    vector<unsigned char> stream(2 * size + 2 * RANS_STATES * RANS_STATE_SIZE);
+    unsigned char* streamEnd = &stream[0] + stream.size();
+    unsigned char* cp = streamEnd;
+
+    unsigned states[RANS_STATES];
+    for (int i = 0; i < RANS_STATES; i++) {
+        states[i] = RANS_LOW_BOUND;
+    }
+    for (size_t i = size; i-- > 0; ) {
+        unsigned& state = states[i % RANS_STATES];
+        const RansSymbol& symbol = symbols[text[i]];
+        unsigned maxState = ((RANS_LOW_BOUND >> RANS_SCALE_BITS) << 8) * symbol.frequency;
+        while (state >= maxState) {
+            *--cp = (unsigned char) state;
+            state >>= 8;
+        }
+        state = ((state / symbol.frequency) << RANS_SCALE_BITS)
+                + (state % symbol.frequency) + symbol.start;
+    }
+    for (int i = RANS_STATES - 1; i >= 0; i--) {
+        cp -= RANS_STATE_SIZE;
+        for (int j = 0; j < RANS_STATE_SIZE; j++) {
+            cp[j] = (unsigned char) (states[i] >> (8 * j));
+        }
+    }
+    data.insert(data.end(), cp, streamEnd);
+}
+
+/* Function: readFrequencies
+ * -------------------------
+ * Reads frequencies header, and checks their sum.
+ */
+static bool readFrequencies(BitReader& reader, int* frequencies) {
+    for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+        int bit = reader.readBit();
+        if (bit == EOF) return false;
+        frequencies[symbol] = bit;
+    }
+    unsigned sum = 0;
+    for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+        if (frequencies[symbol] == 0) continue;
+        long long value = reader.readBits(RANS_SCALE_BITS);
+        if (value == EOF) return false;
+        frequencies[symbol] = (int) value + 1;
+        sum += frequencies[symbol];
+    }
+    reader.alignToByte();
+    return sum == RANS_SCALE;
+}
+
+/* Function: decodeRansBlock
+ * -------------------------
+ * Every state slot is found in the slots table. Decoder
+ * states are back to RANS_LOW_BOUND, and the stream is read
+ * to its end, only if data is right.
+ */
+bool decodeRansBlock(const char* data, size_t dataSize, char* text, size_t textSize) {
+    int frequencies[BYTE_VALUES];
+    BitReader reader(data, dataSize);
+    if (!readFrequencies(reader, frequencies)) {
+        return textSize == 0;
+    }
+    RansSymbol symbols[BYTE_VALUES];
+    buildSymbols(frequencies, symbols);
+    unsigned char slotSymbols[RANS_SCALE];
+    for (int symbol = 0; symbol < BYTE_VALUES; symbol++) {
+        for (unsigned slot = 0; slot < symbols[symbol].frequency; slot++) {
+            slotSymbols[symbols[symbol].start + slot] = (unsigned char) symbol;
+        }
+    }
+
+    const unsigned char* cp = (const unsigned char*) data + reader.bitsRead() / 8;
+    const unsigned char* end = (const unsigned char*) data + dataSize;
+    if (end - cp < RANS_STATES * RANS_STATE_SIZE) return false;
+    unsigned states[RANS_STATES];
+    for (int i = 0; i < RANS_STATES; i++) {
+        states[i] = 0;
+        for (int j = 0; j < RANS_STATE_SIZE; j++) {
+            states[i] |= (unsigned) *cp++ << (8 * j);
+        }
+    }
+
+    /* Whole rounds of all states, then the rest of text */
+    size_t i = 0;
+    size_t roundsEnd = textSize - textSize % RANS_STATES;
+    while (i < textSize) {
+        int stateCount = (i < roundsEnd) ? RANS_STATES : (int) (textSize - i);
+        for (int k = 0; k < stateCount; k++) {
+            unsigned state = states[k];
+            unsigned slot = state & RANS_MASK;
+            unsigned char symbol = slotSymbols[slot];
+            text[i + k] = (char) symbol;
+            state = symbols[symbol].frequency * (state >> RANS_SCALE_BITS)
+                    + slot - symbols[symbol].start;
+            while (state < RANS_LOW_BOUND) {
+                if (cp == end) return false;
+                state = (state << 8) | *cp++;
+            }
+            states[k] = state;
+        }
+        i += stateCount;
+    }
+
+    for (int i = 0; i < RANS_STATES; i++) {
+        if (states[i] != RANS_LOW_BOUND) return false;
+    }
+    return cp == end;
+}
@@ -0,0 +1,69 @@
+/*******************************************************
+* File: HuffmanRans.h
+* --------------------------
+* v.1 2026/10/18
+*
+* rANS (range asymmetric numeral systems) coding of text
+* blocks - other entropy coder for the same byte counts,
+* which Huffman coding uses. Symbol costs fractional count
+* of bits, so skewed texts are coded shorter, and decoding
+* takes one table lookup per symbol.
+*
+* Block data format:
+* - one bit for every byte value if it's present in text;
+* - RANS_SCALE_BITS bits of (frequency - 1) for every
+*   present byte, zero bits up to the next byte;
+* - RANS_STATES states by 4 bytes, little-endian;
+* - bytes of rANS stream.
+*******************************************************/
+
+#ifndef HuffmanRans_Included
+#define HuffmanRans_Included
+
+#include <cstddef>
+#include <vector>
+
+/* Constant: RANS_SCALE_BITS
+ * Frequencies of symbols are normalized to the sum of
+ * 1 << RANS_SCALE_BITS.
+ */
+const int RANS_SCALE_BITS = 14;
+
+/* Constant: RANS_STATES
+ * Count of interleaved coder states. Symbol i is coded by
+ * state i % RANS_STATES, so decoding of next symbols
+ * doesn't wait for the previous one.
+ */
+const int RANS_STATES = 4;
+
+/* Constant: RANS_LOW_BOUND
+ * Lower bound of coder state, which is kept by renormalizing
+ * byte by byte.
+ */
+const unsigned RANS_LOW_BOUND = 1u << 23;
+
+/* Function: normalizeFrequencies
+ * Usage: normalizeFrequencies(counts, frequencies);
+ * -------------------------------------------------
+ * Scales 256 byte counts to frequencies of 1 << RANS_SCALE_BITS
+ * sum. Every present byte gets frequency 1 at least.
+ */
+void normalizeFrequencies(const long long* counts, int* frequencies);
+
+/* Function: encodeRansBlock
+ * Usage: encodeRansBlock(text, size, data);
+ * -----------------------------------------
+ * Codes text block by its own normalized frequencies, and
+ * appends frequencies and rANS stream to data vector.
+ */
+void encodeRansBlock(const unsigned char* text, size_t size, std::vector<char>& data);
+
+/* Function: decodeRansBlock
+ * Usage: if (decodeRansBlock(data, dataSize, text, textSize)) ...
+ * ---------------------------------------------------------------
+ * Decodes textSize bytes from block data. Returns false if
+ * data is broken.
+ */
+bool decodeRansBlock(const char* data, size_t dataSize, char* text, size_t textSize);
+
+#endif
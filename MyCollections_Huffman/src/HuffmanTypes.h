@@ -3,6 +3,38 @@
  * --------------------------
  * v.1 2015/11/10
  *
+ * v.2 2026/10/18
+ * - PSEUDO_EOF is used as end of text symbol
+ * - cypher file header constants are added
+ *
+ * v.3 2026/10/18
+ * - constants of interleaved streams
+ *
+ * v.4 2026/10/18
+ * - Node is compact node of HuffmanTree array
+ *
+ * v.5 2026/10/18
+ * - BLOCKS_RANS_VERSION
+ *
+ * v.6 2026/10/18
+ * - BLOCKS_LZ77_VERSION
+ *
+ * v.7 2026/10/18
+ * - BLOCKS_CONTEXT_VERSION
+ *
+ * v.8 2026/10/18
+ * - BLOCKS_TYPED_FLAG
+ *
+ * v.9 2026/10/18
+ * - Node and HuffmanTree are removed, code lengths are
+ *   built from byte counts without tree
+ *
+ * v.10 2026/10/18
+ * - HEADER_VERSION of single stream files is removed
+ *
+ * v.11 2026/10/18
+ * - BLOCKS_STORED_VERSION
+ *
  * A file containing the types used by the Huffman
  * encoding program.
  */
@@ -18,7 +50,7 @@
  * A type representing a character, a pseudo-eof, or nothing. */
 typedef int ext_char;
 
-/* Constant: PSEUDO_EOF - wasn't used in this programm
+/* Constant: PSEUDO_EOF
  * A constant representing the PSEUDO_EOF marker that you will
  * write at the end of your Huffman-encoded file.
  */
@@ -33,36 +65,67 @@ const ext_char PSEUDO_EOF = 256;
  */
 const ext_char NOT_A_CHAR = 257;
 
-/* Type: Node
- * A node inside a Huffman encoding tree.	 Each node stores four
- * values - the character stored here (or NOT_A_CHAR if the value
- * is not a character), pointers to the 0 and 1 subtrees, and the
- * weight of the tree.
- *
- * You are free to add fields to this class, but please *do not*
- * modify the existing fields here.	 Our testing code relies on
- * these fields being here in order to function correctly, and
- * Very Bad Things will happen if you change or reorder them.
+/* Constant: HEADER_MAGIC
+ * Every cypher file starts from these 3 magic bytes and
+ * format version byte: one of block container versions
+ * (see HuffmanBlocks.h) or ADAPTIVE_VERSION.
  */
-struct Node {
-	/* A pointer to the 0 subtree. */
-    Node* leftChild;
+const char HEADER_MAGIC[] = "HUF";
+const int HEADER_MAGIC_SIZE = 3;
 
-	/* A pointer to the 1 subtree. */
-    Node* rightChild;
+/* Constant: BLOCKS_VERSION
+ * Format version of block container (see HuffmanBlocks.h),
+ * which starts from the same magic bytes.
+ */
+const int BLOCKS_VERSION = 3;
 
-    /* Stores appearence for this node */
-    int symbAppearance;
+/* Constant: BLOCKS_INTERLEAVED_VERSION
+ * Format version of block container, where every block
+ * has INTERLEAVED_STREAMS streams of codes.
+ */
+const int BLOCKS_INTERLEAVED_VERSION = 5;
+
+/* Constant: BLOCKS_RANS_VERSION
+ * Format version of block container, where blocks are
+ * coded by rANS coder (see HuffmanRans.h).
+ */
+const int BLOCKS_RANS_VERSION = 6;
 
-    /* Real symbol */
-    ext_char symbol;
+/* Constant: BLOCKS_LZ77_VERSION
+ * Format version of block container, where blocks are
+ * coded by LZ77 matches and Huffman codes (see HuffmanLz77.h).
+ */
+const int BLOCKS_LZ77_VERSION = 7;
 
-    Node ();
+/* Constant: BLOCKS_CONTEXT_VERSION
+ * Format version of block container, where bytes are coded
+ * by tables of previous byte contexts (see HuffmanContext.h).
+ */
+const int BLOCKS_CONTEXT_VERSION = 8;
 
-    Node (Node* left, Node* right, int app, ext_char symb);
+/* Constant: BLOCKS_STORED_VERSION
+ * Format version of stored container, where the whole text
+ * follows version byte as it is (see HuffmanBlocks.h).
+ */
+const int BLOCKS_STORED_VERSION = 9;
 
-    Node & operator=(const Node  & n);
+/* Constant: BLOCKS_TYPED_FLAG
+ * Flag of block container version byte: data of every block
+ * starts from its type byte, so incompressible blocks are
+ * stored as they are (see BlockType in HuffmanBlocks.h).
+ */
+const int BLOCKS_TYPED_FLAG = 0x80;
+
+/* Constants: INTERLEAVED_STREAMS, INTERLEAVED_JUMP_TABLE_SIZE
+ * Count of streams of interleaved block, and size of jump
+ * table - 4 bytes of size for every stream but last.
+ */
+const int INTERLEAVED_STREAMS = 4;
+const int INTERLEAVED_JUMP_TABLE_SIZE = 4 * (INTERLEAVED_STREAMS - 1);
+
+/* Constant: HEADER_LENGTH_BITS
+ * Count of bits of every code length in the header.
+ */
+const int HEADER_LENGTH_BITS = 4;
 
-    std::string toString();
-};
 #endif
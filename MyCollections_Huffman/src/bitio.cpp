@@ -0,0 +1,185 @@
+/**********************************************************
+* File: bitio.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - memory output and input
+*
+* v.3 2026/10/18
+* - flushBytes()
+*
+* Implementation of BitWriter and BitReader from bitio.h.
+*
+**********************************************************/
+
+#include <cstdio>
+#include "bitio.h"
+
+using namespace std;
+
+BitWriter::BitWriter(ostream& out, int bufferSize) {
+    this->out = &out;
+    bytes = NULL;
+    init(bufferSize);
+}
+
+BitWriter::BitWriter(vector<char>& bytes, int bufferSize) {
+    out = NULL;
+    this->bytes = &bytes;
+    init(bufferSize);
+}
+
+/* Method: init
+ * ------------
+ * Buffer has 8 spare bytes, so pushWord() checks
+ * its fullness only after storing.
+ */
+void BitWriter::init(int bufferSize) {
+    buffer.resize(bufferSize + 8);
+    bufferPos = 0;
+    accumulator = 0;
+    bitCount = 0;
+    flushedBytes = 0;
+}
+
+BitWriter::~BitWriter() {
+    flush();
+}
+
+/* Method: pushWord
+ * -----------------
+ * Moves lowest 32 bits of accumulator into buffer.
+ */
+void BitWriter::pushWord() {
+    char* cp = &buffer[bufferPos];
+    cp[0] = (char) accumulator;
+    cp[1] = (char) (accumulator >> 8);
+    cp[2] = (char) (accumulator >> 16);
+    cp[3] = (char) (accumulator >> 24);
+    bufferPos += 4;
+    accumulator >>= 32;
+    bitCount -= 32;
+    if (bufferPos >= (int) buffer.size() - 8) {
+        writeBuffer();
+    }
+}
+
+void BitWriter::writeBuffer() {
+    if (out != NULL) {
+        out->write(&buffer[0], bufferPos);
+    } else {
+        bytes->insert(bytes->end(), buffer.begin(), buffer.begin() + bufferPos);
+    }
+    flushedBytes += bufferPos;
+    bufferPos = 0;
+}
+
+/* Method: alignToByte
+ * --------------------
+ * Rounds bits count up to whole bytes, and moves
+ * full bytes of accumulator into buffer.
+ */
+void BitWriter::alignToByte() {
+    bitCount = (bitCount + 7) & ~7;
+    while (bitCount >= 8) {
+        buffer[bufferPos++] = (char) accumulator;
+        accumulator >>= 8;
+        bitCount -= 8;
+    }
+    if (bufferPos >= (int) buffer.size() - 8) {
+        writeBuffer();
+    }
+}
+
+void BitWriter::flush() {
+    alignToByte();
+    writeBuffer();
+    if (out != NULL) {
+        out->flush();
+    }
+}
+
+void BitWriter::flushBytes() {
+    while (bitCount >= 8) {
+        buffer[bufferPos++] = (char) accumulator;
+        accumulator >>= 8;
+        bitCount -= 8;
+    }
+    writeBuffer();
+    if (out != NULL) {
+        out->flush();
+    }
+}
+
+long long BitWriter::bitsWritten() const {
+    return 8 * (flushedBytes + bufferPos) + bitCount;
+}
+
+/* Constructor: BitReader
+ * -----------------------
+ * Buffer is empty, so the first refill reads the stream.
+ */
+BitReader::BitReader(istream& in, int bufferSize) {
+    this->in = &in;
+    buffer.resize(bufferSize);
+    source = &buffer[0];
+    bufferPos = 0;
+    bufferEnd = 0;
+    accumulator = 0;
+    bitCount = 0;
+    loadedBytes = 0;
+}
+
+/* Constructor: BitReader
+ * -----------------------
+ * Memory is the only buffer, which is loaded at once.
+ */
+BitReader::BitReader(const char* data, size_t size) {
+    in = NULL;
+    source = data;
+    bufferPos = 0;
+    bufferEnd = size;
+    accumulator = 0;
+    bitCount = 0;
+    loadedBytes = size;
+}
+
+/* Method: readBuffer
+ * -------------------
+ * Reads next block of the stream. Returns false
+ * if nothing is read.
+ */
+bool BitReader::readBuffer() {
+    if (in == NULL) return false;
+    in->read(&buffer[0], buffer.size());
+    bufferEnd = in->gcount();
+    bufferPos = 0;
+    loadedBytes += bufferEnd;
+    return bufferEnd > 0;
+}
+
+long long BitReader::readBits(int count) {
+    if (bitCount < count) {
+        refill();
+        if (bitCount < count) {
+            return EOF;
+        }
+    }
+    long long result = accumulator & ((1ULL << count) - 1);
+    consume(count);
+    return result;
+}
+
+/* Method: alignToByte
+ * --------------------
+ * Accumulator is loaded by whole bytes, so bits of
+ * current byte are the remainder of bits count.
+ */
+void BitReader::alignToByte() {
+    consume(bitCount & 7);
+}
+
+long long BitReader::bitsRead() const {
+    return 8 * (loadedBytes - (long long) (bufferEnd - bufferPos)) - bitCount;
+}
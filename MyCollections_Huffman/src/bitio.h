@@ -0,0 +1,267 @@
+/*******************************************************
+* File: bitio.h
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - bits could be written into and read from memory
+*
+* v.3 2026/10/18
+* - BitWriter::flushBytes() for low latency streams
+*
+* Buffered bit level input and output over ordinary
+* streams - ifbstream and ofbstream files among them,
+* or over memory buffers.
+*
+* Bits go from the lowest bit of every byte, in the same
+* order as ibstream::readBit and obstream::writeBit use,
+* so files written by both layers are compatible.
+*******************************************************/
+
+#ifndef bitio_Included
+#define bitio_Included
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/* Constant: BITIO_BUFFER_SIZE
+ * Default size of internal byte buffers.
+ */
+const int BITIO_BUFFER_SIZE = 1 << 16;
+
+/*
+ * Class: BitWriter
+ * ----------------
+ * Collects bits in 64-bit accumulator, moves them by
+ * 32-bit words into byte buffer, and writes this buffer
+ * into the stream when it's full, or on flush().
+ */
+class BitWriter {
+public:
+    /*
+     * Constructor: BitWriter
+     * Usage: BitWriter writer(outfileStream);
+     * ---------------------------------------
+     * Bits are written from current position of out.
+     */
+    BitWriter(std::ostream& out, int bufferSize = BITIO_BUFFER_SIZE);
+
+    /*
+     * Constructor: BitWriter
+     * Usage: BitWriter writer(bytes);
+     * -------------------------------
+     * Bits are appended to the end of bytes vector.
+     */
+    BitWriter(std::vector<char>& bytes, int bufferSize = BITIO_BUFFER_SIZE);
+
+    /*
+     * Destructor: ~BitWriter
+     * ----------------------
+     * Flushes all written bits.
+     */
+    ~BitWriter();
+
+    /*
+     * Method: writeBits
+     * Usage: writer.writeBits(code, length);
+     * --------------------------------------
+     * Writes count lowest bits of bits param, lowest first.
+     * Count could be up to 64.
+     */
+    void writeBits(unsigned long long bits, int count) {
+        if (count > 32) {
+            writeBits(bits & 0xFFFFFFFFULL, 32);
+            writeBits(bits >> 32, count - 32);
+            return;
+        }
+        accumulator |= bits << bitCount;
+        bitCount += count;
+        if (bitCount >= 32) {
+            pushWord();
+        }
+    }
+
+    /*
+     * Method: writeBit, writeByte
+     * Usage: writer.writeBit(1);
+     *        writer.writeByte(symbol);
+     * ---------------------------------
+     * Writes single bit, or 8 bits of byte value.
+     */
+    void writeBit(int bit) {
+        writeBits(bit & 1, 1);
+    }
+
+    void writeByte(int byte) {
+        writeBits(byte & 0xFF, 8);
+    }
+
+    /*
+     * Method: alignToByte
+     * Usage: writer.alignToByte();
+     * ----------------------------
+     * Pads current byte by zero bits, so next bits
+     * start from new byte.
+     */
+    void alignToByte();
+
+    /*
+     * Method: flush
+     * Usage: writer.flush();
+     * ----------------------
+     * Aligns to byte and writes buffered bytes into stream.
+     */
+    void flush();
+
+    /*
+     * Method: flushBytes
+     * Usage: writer.flushBytes();
+     * ---------------------------
+     * Writes all whole bytes into stream and flushes it, but
+     * keeps bits of unfinished byte, so the bit stream goes on.
+     */
+    void flushBytes();
+
+    /*
+     * Method: bitsWritten
+     * -------------------
+     * Returns count of bits written by this writer,
+     * padding bits included.
+     */
+    long long bitsWritten() const;
+
+private:
+    std::ostream* out;
+    std::vector<char>* bytes;
+    std::vector<char> buffer;
+    int bufferPos;
+    unsigned long long accumulator;
+    int bitCount;
+    long long flushedBytes;
+
+    void init(int bufferSize);
+
+    void pushWord();
+    void writeBuffer();
+};
+
+/*
+ * Class: BitReader
+ * ----------------
+ * Reads stream by big blocks into byte buffer, and keeps
+ * up to 64 next stream bits in accumulator. Decoders peek
+ * accumulator bits and then consume as much as they used.
+ *
+ * Reader reads ahead, so stream position after reading
+ * is undefined - all data after the bits has to be read
+ * by this reader too.
+ */
+class BitReader {
+public:
+    /*
+     * Constructor: BitReader
+     * Usage: BitReader reader(infileStream);
+     * --------------------------------------
+     * Bits are read from current position of in.
+     */
+    BitReader(std::istream& in, int bufferSize = BITIO_BUFFER_SIZE);
+
+    /*
+     * Constructor: BitReader
+     * Usage: BitReader reader(data, size);
+     * ------------------------------------
+     * Bits are read right from size bytes of data,
+     * which has to live while reader is used.
+     */
+    BitReader(const char* data, size_t size);
+
+    /*
+     * Method: refill
+     * Usage: reader.refill();
+     * -----------------------
+     * Loads whole bytes into accumulator while it has
+     * place, so at least 57 bits are available if the
+     * stream isn't over.
+     */
+    void refill() {
+        while (bitCount <= 56) {
+            if ((bufferPos == bufferEnd) && !readBuffer()) {
+                return;
+            }
+            accumulator |= (unsigned long long) (unsigned char) source[bufferPos++] << bitCount;
+            bitCount += 8;
+        }
+    }
+
+    /*
+     * Methods: peek, available, consume
+     * Usage: int length = table.decode(reader.peek(), reader.available(), symbol);
+     *        reader.consume(length);
+     * ----------------------------------------------------------------------------
+     * peek returns accumulator, where next stream bit is the
+     * lowest one. available is count of valid bits in it.
+     * consume removes count bits, which has to be available.
+     */
+    unsigned long long peek() const {
+        return accumulator;
+    }
+
+    int available() const {
+        return bitCount;
+    }
+
+    void consume(int count) {
+        accumulator = (count < 64) ? (accumulator >> count) : 0;
+        bitCount -= count;
+    }
+
+    /*
+     * Method: readBits
+     * Usage: long long value = reader.readBits(8);
+     * --------------------------------------------
+     * Reads count bits, up to 56, lowest first. Returns
+     * EOF (-1) if the stream has not enough bits.
+     */
+    long long readBits(int count);
+
+    /*
+     * Method: readBit
+     * Usage: int bit = reader.readBit();
+     * ----------------------------------
+     * Returns next bit, or EOF (-1) if stream is over.
+     */
+    int readBit() {
+        return (int) readBits(1);
+    }
+
+    /*
+     * Method: alignToByte
+     * Usage: reader.alignToByte();
+     * ----------------------------
+     * Skips the rest of current byte.
+     */
+    void alignToByte();
+
+    /*
+     * Method: bitsRead
+     * ----------------
+     * Returns count of bits consumed by this reader.
+     */
+    long long bitsRead() const;
+
+private:
+    std::istream* in;
+    std::vector<char> buffer;
+    const char* source;
+    size_t bufferPos;
+    size_t bufferEnd;
+    unsigned long long accumulator;
+    int bitCount;
+    long long loadedBytes;
+
+    bool readBuffer();
+};
+
+#endif
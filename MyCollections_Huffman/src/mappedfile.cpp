@@ -0,0 +1,96 @@
+/**********************************************************
+* File: mappedfile.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* Implementation of MappedFile from mappedfile.h.
+*
+**********************************************************/
+
+#include <fstream>
+#include "mappedfile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/* Constructor: MappedFile
+ * -----------------------
+ * Buffer reading is used when mapping fails - for
+ * example for pipes and other not regular files.
+ */
+MappedFile::MappedFile(const string& fileName) {
+    bytes = NULL;
+    length = 0;
+    mapped = false;
+    opened = mapFile(fileName) || readFile(fileName);
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap((void*) bytes, length);
+    }
+#endif
+}
+
+/* Method: mapFile
+ * ---------------
+ * Maps regular file. Empty file is opened without
+ * mapping, as mmap doesn't take zero length.
+ */
+bool MappedFile::mapFile(const string& fileName) {
+#ifndef _WIN32
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return false;
+    }
+    length = info.st_size;
+    if (length == 0) {
+        close(fd);
+        return true;
+    }
+    void* address = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);//mapping keeps its own file reference
+    if (address == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    madvise(address, length, MADV_SEQUENTIAL);
+    bytes = (const unsigned char*) address;
+    mapped = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* Method: readFile
+ * ----------------
+ * Reads the whole file into buffer by big blocks.
+ */
+bool MappedFile::readFile(const string& fileName) {
+    ifstream in(fileName.c_str(), ios::binary);
+    if (!in.is_open()) return false;
+    const size_t blockSize = 1 << 20;
+    size_t readSize = 0;
+    while (true) {
+        buffer.resize(readSize + blockSize);
+        in.read(&buffer[readSize], blockSize);
+        size_t count = in.gcount();
+        readSize += count;
+        if (count < blockSize) break;
+    }
+    buffer.resize(readSize);
+    length = readSize;
+    bytes = (const unsigned char*) (buffer.empty() ? NULL : &buffer[0]);
+    return true;
+}
@@ -0,0 +1,104 @@
+/*******************************************************
+* File: mappedfile.h
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - MemoryBuffer stream buffer over file bytes
+*
+* Read only view of the whole file in memory. File is
+* mapped by mmap where it is supported, or is read into
+* buffer by one read call otherwise.
+*******************************************************/
+
+#ifndef mappedfile_Included
+#define mappedfile_Included
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/*
+ * Class: MappedFile
+ * -----------------
+ * Whole file bytes, which are valid while object lives.
+ * Mapping is advised for sequential access, so kernel
+ * reads ahead the same way as for stream reading.
+ */
+class MappedFile {
+public:
+    /*
+     * Constructor: MappedFile
+     * Usage: MappedFile input(inputFile);
+     * -----------------------------------
+     * Maps or reads fileName. Check isOpen() after.
+     */
+    MappedFile(const std::string& fileName);
+
+    /*
+     * Destructor: ~MappedFile
+     * -----------------------
+     * Unmaps the file.
+     */
+    ~MappedFile();
+
+    /*
+     * Methods: data, size
+     * Usage: countBytes(input.data(), input.size(), counts);
+     * ------------------------------------------------------
+     * Returns first byte of file and count of its bytes.
+     */
+    const unsigned char* data() const {
+        return bytes;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    /*
+     * Methods: isOpen, isMapped
+     * -------------------------
+     * isOpen is false if file could not be read. isMapped is
+     * true if file is mapped and not copied into buffer.
+     */
+    bool isOpen() const {
+        return opened;
+    }
+
+    bool isMapped() const {
+        return mapped;
+    }
+
+private:
+    const unsigned char* bytes;
+    size_t length;
+    bool opened;
+    bool mapped;
+    std::vector<char> buffer;
+
+    bool mapFile(const std::string& fileName);
+    bool readFile(const std::string& fileName);
+
+    /* Object owns mapping, so it can't be copied */
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+/*
+ * Class: MemoryBuffer
+ * -------------------
+ * Input stream buffer over caller memory, which is read in
+ * place, so stream decoders read mapped file without opening
+ * it again. Bytes are never changed, get area just has char*.
+ */
+class MemoryBuffer : public std::streambuf {
+public:
+    MemoryBuffer(const void* data, size_t size) {
+        char* begin = (char*) data;
+        setg(begin, begin, begin + size);
+    }
+};
+
+#endif
@@ -6,13 +6,23 @@
  * - include "vector.h" for keys() function
  * - code fields are renamed
  *
+ * v.3 2026/10/18 - Modified
+ * - iterators give key() and value() references
+ * - const_iterator and not allocating keysView() are added
+ * - size() and isEmpty() are added
+ * - put() counts only new pairs, clear() resets buckets
+ * - rehashing, reserve() and bulk putAll() are added
+ * - getBatch() and containsBatch() prefetch buckets of grouped keys
+ * - stats() reports load factor, chains lengths and probes counters
+ * - tryGet() and remove() are added
+ * - lookups and probes counters are atomic
+ *
  * Current implementation of hashmap has raw study version,
  * it suits only Huffman compression requirements,
  * and could be improved in next versions.
  *
  * Possible improvements:
  * - clear  and deepCopy methods memory management;
- * - rehashing;
  * - iterator has to be bidirectional for STL purpose;
  * - hashCoding for user classes.
  ********************************************************************************************/
@@ -20,13 +30,27 @@
 #ifndef _myMap_h
 #define _myMap_h
 
+#include <atomic>
 #include <iostream>
 #include <cstdlib>
+#include <iterator>
 #include <string>
 #include "error.h"
 #include "hashcode.h"
 #include "vector.h"
 
+/*
+ * Macro: MYMAP_PREFETCH
+ * ---------------------
+ * Hints processor to load memory at address into cache.
+ * It does nothing for compilers without such builtin.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#  define MYMAP_PREFETCH(address) __builtin_prefetch(address)
+#else
+#  define MYMAP_PREFETCH(address) ((void) 0)
+#endif
+
 
 /*
  * Class: MyMap<KeyType, ValueType>
@@ -64,6 +88,22 @@ public:
      */
     virtual ~MyMap();
 
+    /*
+     * Method: size
+     * Usage: int nElems = map.size();
+     * -------------------------------
+     * Returns the number of entries in this map.
+     */
+    int size() const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (map.isEmpty()) ...
+     * -----------------------------
+     * Returns true if this map contains no entries.
+     */
+    bool isEmpty() const;
+
     /*
      * Method: get
      * Usage: ValueType value = map.get(key);
@@ -73,6 +113,16 @@ public:
      */
     ValueType get(const KeyType& key) const;
 
+    /*
+     * Method: tryGet
+     * Usage: if (map.tryGet(key, value)) ...
+     * --------------------------------------
+     * Copies the value associated with key into value param
+     * and returns true, by one bucket search. If there is no
+     * such key - returns false and value isn't changed.
+     */
+    bool tryGet(const KeyType& key, ValueType& value) const;
+
     /*
      * Method: put, add - synonims
      * Usage: map.put(key, value);
@@ -84,6 +134,38 @@ public:
     void put(const KeyType& key, const ValueType& value);
     void add(const KeyType& key, const ValueType& value);
 
+    /*
+     * Method: reserve
+     * Usage: map.reserve(count);
+     * --------------------------
+     * Resizes buckets array once, so count entries could be
+     * put into map without any further rehashing.
+     */
+    void reserve(int count);
+
+    /*
+     * Method: putAll
+     * Usage: map.putAll(keys, values, count);
+     *        map.putAll(std.begin(), std.end());
+     *        map.putAll(otherMap);
+     * ---------------------------------------
+     * Puts every pair from parallel keys and values arrays,
+     * from range of std::pair-like objects (first, second),
+     * or from other map. Table is pre-sized only once.
+     */
+    void putAll(const KeyType* keys, const ValueType* values, int count);
+    template <typename PairIterator>
+    void putAll(PairIterator first, PairIterator last);
+    void putAll(const MyMap& src);
+
+    /*
+     * Method: remove
+     * Usage: map.remove(key);
+     * -----------------------
+     * Removes the pair for key, if it exists.
+     */
+    void remove(const KeyType& key);
+
     /*
      * Method: clear
      * Usage: map.clear();
@@ -101,6 +183,20 @@ public:
      */
     bool containsKey(const KeyType& key) const;
 
+    /*
+     * Method: getBatch, containsBatch
+     * Usage: map.getBatch(keys, count, values);
+     *        map.containsBatch(keys, count, flags);
+     * ---------------------------------------------
+     * Group versions of get and containsKey. Result for keys[i]
+     * is written into out[i]. Keys are hashed by groups, and
+     * their buckets are prefetched before probing, so memory
+     * latency of many independent lookups is overlapped.
+     * getBatch makes error if some key isn't found.
+     */
+    void getBatch(const KeyType* keys, int count, ValueType* out) const;
+    void containsBatch(const KeyType* keys, int count, bool* out) const;
+
     /*
      * Operator: []
      * Usage: map[key]
@@ -144,6 +240,8 @@ public:
      * Usage: Vector<KeyType> keys = map.keys();
      * -----------------------------------------
      * Returns a collection containing all keys in this map.
+     * It copies every key - use keysView() or iterators
+     * to traverse the map without allocation.
      */
     Vector<KeyType> keys() const;
 
@@ -155,12 +253,71 @@ public:
      */
     void toString() const;
 
+    /*
+     * Type: Stats
+     * -----------
+     * Snapshot of map internal state, which is returned
+     * by stats() method.
+     *
+     * chainLengthHistogram[n] is the count of buckets with
+     * chain of n pairs. meanChainLength is counted through
+     * not empty buckets only - it's the average length of
+     * traversed chain for existed key.
+     * lookups and probes are counted only while probes
+     * counting is enabled: every bucket search is a lookup,
+     * and every visited pair during it is a probe.
+     */
+    struct Stats {
+        int elements;
+        int buckets;
+        double loadFactor;
+        int maxChainLength;
+        double meanChainLength;
+        Vector<int> chainLengthHistogram;
+        int rehashes;
+        long lookups;
+        long probes;
+    };
+
+    /*
+     * Method: stats
+     * Usage: MyMap<KeyType, ValueType>::Stats st = map.stats();
+     * ---------------------------------------------------------
+     * Returns current map statistics. Traverses buckets
+     * array once, nothing is printed.
+     */
+    Stats stats() const;
+
+    /*
+     * Method: setProbesCounting, resetStats
+     * Usage: map.setProbesCounting(true);
+     *        map.resetStats();
+     * ----------------------------------------
+     * Enables or disables lookups and probes counters, which
+     * are off by default. resetStats() sets lookups, probes
+     * and rehashes counters to zero.
+     * Counters are atomic, so const lookups of shared map,
+     * as getBatch from several threads, could be counted.
+     * setProbesCounting and resetStats change the map, and
+     * must not be called while other threads use it.
+     */
+    void setProbesCounting(bool enabled);
+    void resetStats();
+
 /* -----------------------------------------------------------------------------------------//
  * Iterator support
  * ----------------
- * Implementation for the map object input iterator.
+ * Implementation for the map object input iterators.
  * -----------------------------------------------------------------------------------------*/
-    class iterator : public std::iterator<std::input_iterator_tag, KeyType> {
+    /*
+     * Class: MyMap<KeyType, ValueType>::basic_iterator
+     * ------------------------------------------------
+     * Common implementation for iterator and const_iterator.
+     * MapPointer, PairPointer and ValueReference are the
+     * mutable or const flavours of map, pair and value access.
+     */
+    template <typename MapPointer, typename PairPointer, typename ValueReference>
+    class basic_iterator : public std::iterator<std::input_iterator_tag, KeyType> {
         /*
          * Implementation notes: MyMap iterator
          * ------------------------------------
@@ -173,18 +330,21 @@ public:
          * But we could create several iterator objects for
          * our goals.
          *
-         * Iterator implemented as input iterator, because of
-         * our goals had no needs change map by iterators.
-         * We don't overload "=" operator for it.
+         * Dereferencing gives the key, so old "for (key : map)"
+         * loops still work. key() and value() give direct
+         * references into the current Pair, so the whole map
+         * could be scanned without any extra get() lookups.
+         * Keys are always read only - changing a key in place
+         * would break its bucket position.
          *
          * std::input_iterator_tag...  - Empty class to identify
          * the category of an iterator as an input iterator
          */
     private:
 
-        const MyMap* thisMap;        /* Pointer to the map                      */
+        MapPointer thisMap;          /* Pointer to the map                      */
         int bucket;                  /* Index of current bucket                 */
-        MyMap::Pair* currentPair;    /* Pointer to current cell in bucket chain */
+        PairPointer currentPair;     /* Pointer to current cell in bucket chain */
 
     public:
 
@@ -195,7 +355,7 @@ public:
          * During MyMap object initiation, this
          * defalut iterator is created too.
          */
-        iterator() : thisMap(NULL), bucket(0), currentPair(0) {
+        basic_iterator() : thisMap(NULL), bucket(0), currentPair(NULL) {
             /* Empty */
         }
 
@@ -216,7 +376,7 @@ public:
          * @param end   true if the end iterator
          *              construction called
          */
-        iterator(const MyMap* thisMap, bool end) {
+        basic_iterator(MapPointer thisMap, bool end) {
             /* Tight connection with particular MyMap object. */
             this->thisMap = thisMap;
             if (end) {//If end flag - create end iterator
@@ -241,13 +401,13 @@ public:
         }
 
         /*
-         * Method: copy constructor
-         * ----------------------
-         * Provides correct passing of iterator
-         * by value, or new iterator initiation,
-         * if it needs for current MyMap object.
+         * Method: converting constructor
+         * ------------------------------
+         * Provides copying of the iterator, and
+         * iterator to const_iterator conversion.
          */
-        iterator(const iterator& it) {
+        template <typename OtherMap, typename OtherPair, typename OtherValue>
+        basic_iterator(const basic_iterator<OtherMap, OtherPair, OtherValue>& it) {
             thisMap = it.thisMap;
             bucket = it.bucket;
             currentPair = it.currentPair;
@@ -260,7 +420,7 @@ public:
          * Moves iterator into the next map pair,
          * and then, returns this iterator reference.
          */
-        iterator& operator++() {
+        basic_iterator& operator++() {
             currentPair = currentPair->link;//Move this iterator to the next pair
             while ((currentPair == NULL) && (++bucket < thisMap->numBuckets)) {
                 /* If the pair binded with this bucket isn't
@@ -280,8 +440,8 @@ public:
          * current iterator is moved into
          * the next map pair.
          */
-        iterator operator ++(int) {
-            iterator copy(*this);
+        basic_iterator operator ++(int) {
+            basic_iterator copy(*this);
             operator++();
             return copy;
         }
@@ -295,11 +455,11 @@ public:
          * the same map pair, due to it's
          * position in buckets ctructure.
          */
-        bool operator ==(const iterator& rhs) {
+        bool operator ==(const basic_iterator& rhs) const {
             return thisMap == rhs.thisMap && bucket == rhs.bucket && currentPair == rhs.currentPair;
         }
 
-        bool operator !=(const iterator& rhs) {
+        bool operator !=(const basic_iterator& rhs) const {
             return !(*this == rhs);
         }
 
@@ -310,7 +470,7 @@ public:
          * Returns key value for pair
          * which iterator points currently
          */
-        KeyType& operator *() {
+        const KeyType& operator *() const {
             return currentPair->key;
         }
 
@@ -320,14 +480,45 @@ public:
          * Returns pointer on the key value for pair
          * which iterator points currently
          */
-        KeyType* operator ->() {
+        const KeyType* operator ->() const {
             return &currentPair->key;
         }
 
+        /*
+         * Method: key
+         * Usage: KeyType key = iter.key();
+         * --------------------------------
+         * Returns reference on the key of current pair.
+         */
+        const KeyType& key() const {
+            return currentPair->key;
+        }
+
+        /*
+         * Method: value
+         * Usage: iter.value()++;
+         * ----------------------
+         * Returns reference on the value of current pair.
+         * For const_iterator this reference is read only.
+         */
+        ValueReference value() const {
+            return currentPair->data;
+        }
+
         /* Friends */
         friend class MyMap;
+        template <typename, typename, typename> friend class basic_iterator;
     };
 
+    /*
+     * Type: iterator, const_iterator
+     * ------------------------------
+     * iterator allows to change values in place, const_iterator
+     * is returned for const maps and only reads pairs.
+     */
+    typedef basic_iterator<MyMap*, Pair*, ValueType&> iterator;
+    typedef basic_iterator<const MyMap*, const Pair*, const ValueType&> const_iterator;
+
     /*
      * Method: begin
      * Usage: MyMap<KeyType, ValueType>::iterator iter = mmp.begin()
@@ -335,10 +526,14 @@ public:
      * Returns iterator object pointed
      * on the start pair of the map.
      */
-    iterator begin() const {
+    iterator begin() {
         return iterator(this, false);
     }
 
+    const_iterator begin() const {
+        return const_iterator(this, false);
+    }
+
     /*
      * Method: end
      * Usage: if (iter == mmp.end()){...}
@@ -349,10 +544,53 @@ public:
      * It uses only for "end of map" checking
      * condition, to stop iteration etc.
      */
-    iterator end() const {
+    iterator end() {
         return iterator(this, true);
     }
 
+    const_iterator end() const {
+        return const_iterator(this, true);
+    }
+
+    /*
+     * Class: MyMap<KeyType, ValueType>::KeysView
+     * ------------------------------------------
+     * Read only range over the keys of the map. It keeps
+     * only pointer on the map, so nothing is copied or
+     * allocated. View is valid while the map isn't changed.
+     */
+    class KeysView {
+    public:
+        KeysView(const MyMap* thisMap) : thisMap(thisMap) {
+            /* Empty */
+        }
+
+        const_iterator begin() const {
+            return thisMap->begin();
+        }
+
+        const_iterator end() const {
+            return thisMap->end();
+        }
+
+        int size() const {
+            return thisMap->size();
+        }
+
+    private:
+        const MyMap* thisMap;
+    };
+
+    /*
+     * Method: keysView
+     * Usage: for (KeyType key : map.keysView()) {...}
+     * -----------------------------------------------
+     * Returns not allocating view over the map keys.
+     */
+    KeysView keysView() const {
+        return KeysView(this);
+    }
+
 /* -----------------------------------------------------------------------------------------//
  * Private section
  * -----------------------------------------------------------------------------------------*/
@@ -393,9 +631,15 @@ private:
      };
 
     static const int INITIAL_BUCKET_COUNT = 30; //Initial buckets array length.
+    static const int MAX_LOAD_FACTOR = 1;       //Entries per bucket before rehashing.
+    static const int BATCH_GROUP_SIZE = 16;     //Keys hashed together by batch lookups.
     Pair ** buckets;                //High level array of pointers to Pairs.
     int numBuckets;                 //Current buckets array length - for rehashing purpose.
     int numElements;                //Quantity of inputed user entries.
+    int numRehashes;                //Count of buckets array resizings.
+    bool countProbes;               //True if lookups and probes are counted.
+    mutable std::atomic<long> numLookups; //Count of bucket searches.
+    mutable std::atomic<long> numProbes;  //Count of pairs visited by searches.
 
     /*
      * Private method: findCell
@@ -405,10 +649,22 @@ private:
      * in current bucket list. If such key entry isn't exist
      * in list - returns NULL.
      * Traverses through every element of this list.
+     * Probes counting is made in separate branch, so
+     * usual searches don't pay for it. Probes are summed
+     * locally and added to shared counter once per search.
      */
     Pair *findCell(int bucket, const KeyType& key) const{
         /* Takes pointer on the binded pair */
         Pair *cp = buckets[bucket];
+        if (countProbes) {
+            long probes = 0;
+            while ((cp != NULL) && (probes++, cp->key != key)) {
+                cp = cp->link;
+            }
+            numLookups.fetch_add(1, std::memory_order_relaxed);
+            numProbes.fetch_add(probes, std::memory_order_relaxed);
+            return cp;
+        }
         /* Starting from this pair - traverses through list */
         while((cp != NULL) && (cp->key != key)){
             cp = cp->link;
@@ -422,6 +678,24 @@ private:
      * Implements deep copy process
      */
     void deepCopy(const MyMap& src);
+
+    /*
+     * Private method: rehash
+     * ----------------------
+     * Moves all pairs into new buckets array of
+     * newBucketCount length.
+     */
+    void rehash(int newBucketCount);
+
+    /*
+     * Private method: probeBatch
+     * --------------------------
+     * Common part of batch lookups: hashes group of keys,
+     * prefetches buckets cells and first pairs of chains,
+     * and then calls fn(index, pair) for every key.
+     */
+    template <typename ProbeFunctor>
+    void probeBatch(const KeyType* keys, int count, ProbeFunctor fn) const;
 };
 
 
@@ -448,6 +722,10 @@ MyMap<KeyType, ValueType>::MyMap() {
         buckets[i] = NULL;
     }
     numElements = 0;
+    numRehashes = 0;
+    countProbes = false;
+    numLookups = 0;
+    numProbes = 0;
 }
 
 /*
@@ -471,6 +749,21 @@ MyMap<KeyType, ValueType>::~MyMap() {
     delete[] buckets;
 }
 
+/*
+ * Implementation notes: size, isEmpty
+ * -----------------------------------
+ * Returns value of pairs counter.
+ */
+template <typename KeyType, typename ValueType>
+int MyMap<KeyType, ValueType>::size() const {
+    return numElements;
+}
+
+template <typename KeyType, typename ValueType>
+bool MyMap<KeyType, ValueType>::isEmpty() const {
+    return (numElements == 0);
+}
+
 /*
  * Implementation notes: get
  * ---------------------------
@@ -486,6 +779,17 @@ ValueType MyMap<KeyType, ValueType>::get(const KeyType& key) const {
     return (cp == NULL) ? ValueType() : cp->data;
 }
 
+template <typename KeyType, typename ValueType>
+bool MyMap<KeyType, ValueType>::tryGet(const KeyType& key, ValueType& value) const {
+    int bucket = hashCode(key) % numBuckets;
+    Pair * cp = findCell(bucket, key);
+    if (cp == NULL) {
+        return false;
+    }
+    value = cp->data;
+    return true;
+}
+
 /*
  * Implementation notes: put
  * ---------------------------
@@ -505,6 +809,12 @@ void MyMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
          * New cell will be binded with buckets[] cell and her link will
          * be old cell in this list */
 
+        /* Keep chains short - grow buckets array if it's full */
+        if (numElements >= numBuckets * MAX_LOAD_FACTOR) {
+            rehash(2 * numBuckets + 1);
+            bucket = hashCode(key) % numBuckets;
+        }
+
         /* Create a new cell to hold the key/value pair. */
         cp = new Pair;
         cp->key = key;
@@ -512,9 +822,9 @@ void MyMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value)
         cp->link = buckets[bucket];
         /* Now buckets array cell points right on the new entry cell */
         buckets[bucket] = cp;
+        numElements++;
     }
     cp->data = value;//Upate value.
-    numElements++;
 }
 
 template <typename KeyType, typename ValueType>
@@ -522,6 +832,74 @@ void MyMap<KeyType, ValueType>::add(const KeyType& key, const ValueType& value)
     put(key, value);
 }
 
+/*
+ * Implementation notes: reserve
+ * -----------------------------
+ * Rehashes only if count doesn't fit current
+ * buckets array.
+ */
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::reserve(int count) {
+    if (count > numBuckets * MAX_LOAD_FACTOR) {
+        rehash(count / MAX_LOAD_FACTOR + 1);
+    }
+}
+
+/*
+ * Implementation notes: putAll
+ * ----------------------------
+ * Reserves place for all new pairs first, then puts
+ * them one by one. Repeated keys only update values.
+ */
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::putAll(const KeyType* keys, const ValueType* values, int count) {
+    reserve(numElements + count);
+    for (int i = 0; i < count; i++) {
+        put(keys[i], values[i]);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+template <typename PairIterator>
+void MyMap<KeyType, ValueType>::putAll(PairIterator first, PairIterator last) {
+    reserve(numElements + (int) std::distance(first, last));
+    for (PairIterator it = first; it != last; ++it) {
+        put(it->first, it->second);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::putAll(const MyMap& src) {
+    if (this == &src) {
+        return;
+    }
+    reserve(numElements + src.numElements);
+    for (const_iterator it = src.begin(); it != src.end(); ++it) {
+        put(it.key(), it.value());
+    }
+}
+
+/*
+ * Implementation notes: remove
+ * ----------------------------
+ * Walks the bucket list by pointer on the previous link,
+ * so the found Pair is unbound without second search.
+ */
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::remove(const KeyType& key) {
+    int bucket = hashCode(key) % numBuckets;
+    Pair ** cp = &buckets[bucket];
+    while ((*cp != NULL) && ((*cp)->key != key)) {
+        cp = &(*cp)->link;
+    }
+    if (*cp != NULL) {
+        Pair * oldPair = *cp;
+        *cp = oldPair->link;
+        delete oldPair;
+        numElements--;
+    }
+}
+
 /*
  * Implementation notes: clear
  * ---------------------------
@@ -537,8 +915,9 @@ void MyMap<KeyType, ValueType>::clear() {
             cp = cp->link;
             delete oldPair;
         }
+        buckets[i] = NULL;
     }
-   numElements = 0;
+    numElements = 0;
 }
 
 /*
@@ -558,6 +937,27 @@ bool MyMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
     }
 }
 
+/*
+ * Implementation notes: getBatch, containsBatch
+ * ---------------------------------------------
+ * Both are built on probeBatch, which hides memory
+ * latency of buckets loading.
+ */
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::getBatch(const KeyType* keys, int count, ValueType* out) const {
+    probeBatch(keys, count, [out](int i, const Pair* cp) {
+        if (cp == NULL) error("getBatch: No pair for this key: ");
+        out[i] = cp->data;
+    });
+}
+
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::containsBatch(const KeyType* keys, int count, bool* out) const {
+    probeBatch(keys, count, [out](int i, const Pair* cp) {
+        out[i] = (cp != NULL);
+    });
+}
+
 /*
  * Implementation notes: MyMap [] selection
  * -----------------------------------------
@@ -645,6 +1045,56 @@ void MyMap<KeyType, ValueType>::toString() const {
     }
 }
 
+/*
+ * Implementation notes: stats
+ * ---------------------------
+ * Measures every chain length once. Histogram has
+ * maxChainLength + 1 cells.
+ */
+template <typename KeyType, typename ValueType>
+typename MyMap<KeyType, ValueType>::Stats MyMap<KeyType, ValueType>::stats() const {
+    Stats result;
+    result.elements = numElements;
+    result.buckets = numBuckets;
+    result.loadFactor = (double) numElements / numBuckets;
+    result.maxChainLength = 0;
+    result.rehashes = numRehashes;
+    result.lookups = numLookups.load(std::memory_order_relaxed);
+    result.probes = numProbes.load(std::memory_order_relaxed);
+
+    int usedBuckets = 0;
+    for (int i = 0; i < numBuckets; i++) {
+        int chainLength = 0;
+        for (Pair* cp = buckets[i]; cp != NULL; cp = cp->link) {
+            chainLength++;
+        }
+        while (result.chainLengthHistogram.size() <= chainLength) {
+            result.chainLengthHistogram.add(0);
+        }
+        result.chainLengthHistogram[chainLength]++;
+        if (chainLength > result.maxChainLength) {
+            result.maxChainLength = chainLength;
+        }
+        if (chainLength > 0) {
+            usedBuckets++;
+        }
+    }
+    result.meanChainLength = (usedBuckets == 0) ? 0.0 : (double) numElements / usedBuckets;
+    return result;
+}
+
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::setProbesCounting(bool enabled) {
+    countProbes = enabled;
+}
+
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::resetStats() {
+    numRehashes = 0;
+    numLookups = 0;
+    numProbes = 0;
+}
+
 /*
  * Private function: deepCopy
  * -----------------------------------------
@@ -661,6 +1111,10 @@ void MyMap<KeyType, ValueType>::deepCopy(const MyMap& src) {
         buckets[i] = NULL;
     }
     numElements = 0;//Put method will set right value.
+    numRehashes = 0;
+    countProbes = src.countProbes;
+    numLookups = 0;
+    numProbes = 0;
     /* Run through the src map buckets and put elements to this */
     for (int i = 0; i < numBuckets; i++) {
         for (Pair * cp = src.buckets[i]; cp != NULL; cp = cp->link) {
@@ -670,4 +1124,65 @@ void MyMap<KeyType, ValueType>::deepCopy(const MyMap& src) {
 }
 
 
+/*
+ * Private function: rehash
+ * -----------------------------------------
+ * Creates new buckets array and rebinds every existed
+ * Pair into it. Pairs themselves aren't reallocated.
+ */
+template <typename KeyType, typename ValueType>
+void MyMap<KeyType, ValueType>::rehash(int newBucketCount) {
+    Pair ** newBuckets = new Pair*[newBucketCount];
+    for (int i = 0; i < newBucketCount; i++) {
+        newBuckets[i] = NULL;
+    }
+    for (int i = 0; i < numBuckets; i++) {
+        Pair * cp = buckets[i];
+        while (cp != NULL) {
+            Pair * nextPair = cp->link;
+            int bucket = hashCode(cp->key) % newBucketCount;
+            cp->link = newBuckets[bucket];
+            newBuckets[bucket] = cp;
+            cp = nextPair;
+        }
+    }
+    delete[] buckets;
+    buckets = newBuckets;
+    numBuckets = newBucketCount;
+    numRehashes++;
+}
+
+/*
+ * Private function: probeBatch
+ * -----------------------------------------
+ * Works by groups of BATCH_GROUP_SIZE keys in three stages:
+ * - hashes every key and prefetches its buckets[] cell;
+ * - reads buckets cells and prefetches first chain pairs;
+ * - probes chains, which are mostly in cache already.
+ * So loads of the whole group are in flight together, instead
+ * of one cache miss after another.
+ */
+template <typename KeyType, typename ValueType>
+template <typename ProbeFunctor>
+void MyMap<KeyType, ValueType>::probeBatch(const KeyType* keys, int count, ProbeFunctor fn) const {
+    int groupBuckets[BATCH_GROUP_SIZE];
+    for (int start = 0; start < count; start += BATCH_GROUP_SIZE) {
+        int groupSize = count - start;
+        if (groupSize > BATCH_GROUP_SIZE) {
+            groupSize = BATCH_GROUP_SIZE;
+        }
+        for (int i = 0; i < groupSize; i++) {
+            groupBuckets[i] = hashCode(keys[start + i]) % numBuckets;
+            MYMAP_PREFETCH(&buckets[groupBuckets[i]]);
+        }
+        for (int i = 0; i < groupSize; i++) {
+            MYMAP_PREFETCH(buckets[groupBuckets[i]]);
+        }
+        for (int i = 0; i < groupSize; i++) {
+            fn(start + i, findCell(groupBuckets[i], keys[start + i]));
+        }
+    }
+}
+
+
 #endif
@@ -0,0 +1,192 @@
+/*******************************************************
+* File: pipeline.h
+* --------------------------
+* v.1 2026/10/18
+*
+* Parts of thread pipelines: bounded ring of items between
+* one producer and one consumer thread, and stage thread,
+* which runs one step of the pipeline - reading, coding or
+* writing - while other stages run their own ones.
+*******************************************************/
+
+#ifndef pipeline_Included
+#define pipeline_Included
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+ * Class: SpscRing
+ * ---------------
+ * Ring of capacity slots. Producer and consumer touch
+ * only own index, so items go through without lock, and
+ * mutex is taken only to sleep when ring is full or empty.
+ * Items are moved, so big buffers are not copied.
+ */
+template <typename T>
+class SpscRing {
+public:
+    /*
+     * Constructor: SpscRing
+     * Usage: SpscRing<Chunk> ring(capacity);
+     * --------------------------------------
+     * Makes empty open ring.
+     */
+    SpscRing(size_t capacity) : slots(capacity), head(0), tail(0), closed(false) {
+    }
+
+    /*
+     * Method: push
+     * Usage: if (ring.push(item)) ...
+     * -------------------------------
+     * Moves item into ring, waits while ring is full.
+     * Returns false if ring is closed, item stays then.
+     */
+    bool push(T& item) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        waitFor([this, position] {
+            return closed.load() || (position - head.load(std::memory_order_acquire) < slots.size());
+        });
+        if (closed.load()) return false;
+        slots[position % slots.size()] = std::move(item);
+        tail.store(position + 1, std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    /*
+     * Method: pop
+     * Usage: while (ring.pop(item)) ...
+     * ---------------------------------
+     * Moves the oldest item out of ring, waits while ring is
+     * empty. Items pushed before close are still popped, and
+     * then pop returns false.
+     */
+    bool pop(T& item) {
+        size_t position = head.load(std::memory_order_relaxed);
+        waitFor([this, position] {
+            return closed.load() || (tail.load(std::memory_order_acquire) != position);
+        });
+        if (tail.load(std::memory_order_acquire) == position) return false;
+        item = std::move(slots[position % slots.size()]);
+        head.store(position + 1, std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    /*
+     * Method: close
+     * Usage: ring.close();
+     * --------------------
+     * Ends ring: producer says there are no more items, or
+     * any side gives up after error. Waiting side wakes up.
+     */
+    void close() {
+        closed.store(true);
+        wake();
+    }
+
+private:
+    std::vector<T> slots;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<bool> closed;
+    std::mutex ringMutex;
+    std::condition_variable changed;
+
+    template <typename Predicate>
+    void waitFor(Predicate ready) {
+        if (ready()) return;
+        std::unique_lock<std::mutex> lock(ringMutex);
+        changed.wait(lock, ready);
+    }
+
+    /* Lock makes sure, that waiting side either sees the
+     * change or already sleeps and gets notification */
+    void wake() {
+        std::lock_guard<std::mutex> lock(ringMutex);
+        changed.notify_all();
+    }
+
+    /* Ring can't be copied */
+    SpscRing(const SpscRing&);
+    SpscRing& operator=(const SpscRing&);
+};
+
+/*
+ * Class: PipelineStage
+ * --------------------
+ * Thread, which runs stage task and then closes its ring:
+ * reader stage closes ring it fills, so the end of input
+ * is the end of ring, and writer stage closes ring it
+ * empties, so producer stops if writer fails. Exception
+ * of task is kept and thrown again by finish.
+ */
+template <typename T>
+class PipelineStage {
+public:
+    /*
+     * Constructor: PipelineStage
+     * Usage: PipelineStage<Chunk> writer(ring, [&] { ... });
+     * ------------------------------------------------------
+     * Starts task in new thread.
+     */
+    PipelineStage(SpscRing<T>& ring, const std::function<void()>& task)
+        : ring(ring), failure(nullptr) {
+        worker = std::thread([this, task] {
+            try {
+                task();
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            this->ring.close();
+        });
+    }
+
+    /*
+     * Destructor: ~PipelineStage
+     * --------------------------
+     * Closes ring, so stage stops soon, and joins thread.
+     * Stage is left so, when other stage has failed.
+     */
+    ~PipelineStage() {
+        ring.close();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    /*
+     * Method: finish
+     * Usage: stage.finish();
+     * ----------------------
+     * Waits for the end of task. Throws exception of task,
+     * if it has failed.
+     */
+    void finish() {
+        if (worker.joinable()) {
+            worker.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+private:
+    SpscRing<T>& ring;
+    std::exception_ptr failure;
+    std::thread worker;
+
+    /* Threads can't be copied */
+    PipelineStage(const PipelineStage&);
+    PipelineStage& operator=(const PipelineStage&);
+};
+
+#endif
@@ -0,0 +1,308 @@
+/**********************************************************
+* File: CollectionsTests.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - reserve, putAll, batch lookups and iteration of MyMap
+*
+* v.3 2026/10/18
+* - probes counting of MyMap shared by threads
+*
+* Implementation of the tests from CollectionsTests.h.
+*
+**********************************************************/
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "CollectionsTests.h"
+#include "error.h"
+#include "myLruMap.h"
+#include "myMap.h"
+
+using namespace std;
+
+/* Function: testLruRecencyOrder
+ * -----------------------------
+ * Pair, which was got or put the last, stays, and the least
+ * recently used one is evicted. containsKey doesn't change
+ * the order.
+ */
+static bool testLruRecencyOrder() {
+    MyLruMap<int, int> cache(3);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    bool isPassed = (cache.get(1) == 10);
+    cache.put(4, 40);
+    isPassed = isPassed && !cache.containsKey(2) && cache.containsKey(1)
+            && cache.containsKey(3) && cache.containsKey(4);
+
+    cache.put(3, 33);
+    cache.containsKey(1);
+    cache.put(5, 50);
+    int value = 0;
+    isPassed = isPassed && !cache.containsKey(1) && cache.tryGet(3, value) && (value == 33)
+            && (cache.size() == 3);
+
+    cache.remove(3);
+    isPassed = isPassed && !cache.containsKey(3) && (cache.size() == 2);
+    cache.clear();
+    return isPassed && cache.isEmpty() && !cache.tryGet(4, value) && (cache.bytes() == 0);
+}
+
+/* Function: testLruCapacity
+ * -------------------------
+ * Full cache of capacity bigger then its initial index keeps
+ * exactly the last capacity keys.
+ */
+static bool testLruCapacity() {
+    const int capacity = 10000;
+    MyLruMap<int, int> cache(capacity);
+    for (int key = 0; key < 3 * capacity; key++) {
+        cache.put(key, key * 2);
+    }
+    bool isPassed = (cache.size() == capacity) && (cache.capacity() == capacity)
+            && (cache.evictions() == 2 * capacity);
+    for (int key = 0; isPassed && (key < 3 * capacity); key++) {
+        int value = -1;
+        bool isFound = cache.tryGet(key, value);
+        isPassed = (isFound == (key >= 2 * capacity)) && (!isFound || (value == key * 2));
+    }
+    return isPassed;
+}
+
+/* Function: testLruByteBudget
+ * ---------------------------
+ * Sum of costs never exceeds the budget, also when the cost
+ * of one pair alone is bigger then it.
+ */
+static bool testLruByteBudget() {
+    MyLruMap<int, int> cache(100, 10);
+    cache.put(1, 1, 4);
+    cache.put(2, 2, 4);
+    cache.put(3, 3, 4);
+    bool isPassed = (cache.byteBudget() == 10) && (cache.bytes() == 8)
+            && !cache.containsKey(1) && (cache.size() == 2);
+
+    cache.put(2, 2, 7);
+    isPassed = isPassed && (cache.bytes() == 7) && !cache.containsKey(3)
+            && cache.containsKey(2);
+
+    cache.put(4, 4, 100);
+    isPassed = isPassed && cache.isEmpty() && (cache.bytes() == 0);
+
+    cache.put(5, 5, 10);
+    return isPassed && (cache.size() == 1) && (cache.bytes() == 10);
+}
+
+/* Function: testLruCallbackAndCounters
+ * ------------------------------------
+ * Callback gets every evicted pair, the oversize one too,
+ * but not removed or cleared ones. Counters count hits,
+ * misses and evictions until reset.
+ */
+static bool testLruCallbackAndCounters() {
+    MyLruMap<string, int> cache(2, 100);
+    vector<string> evicted;
+    int evictedSum = 0;
+    cache.setEvictionCallback([&](const string& key, int& value) {
+        evicted.push_back(key);
+        evictedSum += value;
+    });
+    cache.put("a", 1, 10);
+    cache.put("b", 2, 10);
+    cache.get("a");
+    cache.put("c", 3, 10);
+    int value = 0;
+    cache.tryGet("b", value);
+    cache.remove("a");
+    cache.put("huge", 4, 1000);
+    cache.put("d", 5, 10);
+    cache.tryGet("d", value);
+    cache.clear();
+
+    bool isPassed = (evicted.size() == 3) && (evicted[0] == "b") && (evicted[1] == "c")
+            && (evicted[2] == "huge") && (evictedSum == 9);
+    isPassed = isPassed && (cache.hits() == 2) && (cache.misses() == 1)
+            && (cache.evictions() == 3);
+    cache.resetCounters();
+    return isPassed && (cache.hits() == 0) && (cache.misses() == 0) && (cache.evictions() == 0);
+}
+
+/* Function: testMapReserveAndPutAll
+ * ----------------------------------
+ * Reserved map isn't rehashed while reserved count of
+ * pairs is put. Every putAll form puts all its pairs,
+ * and repeated keys only update values.
+ */
+static bool testMapReserveAndPutAll() {
+    MyMap<int, int> map;
+    map.reserve(1000);
+    int rehashes = map.stats().rehashes;
+    for (int key = 0; key < 1000; key++) {
+        map.put(key, key);
+    }
+    bool isPassed = (map.size() == 1000) && (map.stats().rehashes == rehashes);
+
+    int keys[] = {5, 2000, 2001, 2000};
+    int values[] = {-5, 1, 2, 3};
+    map.putAll(keys, values, 4);
+    isPassed = isPassed && (map.size() == 1002) && (map.get(5) == -5) && (map.get(2000) == 3);
+
+    vector<pair<int, int> > pairs;
+    for (int key = 3000; key < 3500; key++) {
+        pairs.push_back(make_pair(key, key + 1));
+    }
+    MyMap<int, int> other;
+    other.putAll(pairs.begin(), pairs.end());
+    isPassed = isPassed && (other.size() == 500) && (other.get(3499) == 3500)
+            && (other.stats().rehashes == 1);
+
+    map.putAll(other);
+    map.putAll(map);
+    return isPassed && (map.size() == 1502) && (map.get(3000) == 3001) && (map.get(999) == 999);
+}
+
+/* Function: testMapBatchLookups
+ * -----------------------------
+ * Batch lookups, which are longer then one group and not
+ * multiple of it, give the same results as single ones.
+ * getBatch fails on missing key.
+ */
+static bool testMapBatchLookups() {
+    MyMap<int, int> map;
+    for (int key = 0; key < 100; key += 2) {
+        map.put(key, key * 3);
+    }
+    const int count = 37;
+    int keys[count];
+    int values[count];
+    bool flags[count];
+    for (int i = 0; i < count; i++) {
+        keys[i] = (i * 7) % 100;
+    }
+    map.containsBatch(keys, count, flags);
+    bool isPassed = true;
+    for (int i = 0; i < count; i++) {
+        isPassed = isPassed && (flags[i] == map.containsKey(keys[i]));
+    }
+
+    for (int i = 0; i < count; i++) {
+        keys[i] = (i * 14) % 100;
+    }
+    map.getBatch(keys, count, values);
+    for (int i = 0; i < count; i++) {
+        isPassed = isPassed && (values[i] == keys[i] * 3);
+    }
+
+    keys[count - 1] = 1;
+    bool isFailed = false;
+    try {
+        map.getBatch(keys, count, values);
+    } catch (ErrorException&) {
+        isFailed = true;
+    }
+    return isPassed && isFailed;
+}
+
+/* Function: testMapIterationAfterRehash
+ * -------------------------------------
+ * After many rehashes and removes iterator visits every
+ * pair once, values are changed in place, and keysView
+ * sees the same pairs.
+ */
+static bool testMapIterationAfterRehash() {
+    const int count = 5000;
+    MyMap<int, int> map;
+    for (int key = 0; key < count; key++) {
+        map.put(key, key);
+    }
+    for (int key = 0; key < count; key += 5) {
+        map.remove(key);
+    }
+    bool isPassed = (map.stats().rehashes > 0) && (map.size() == count - count / 5);
+
+    vector<int> visits(count, 0);
+    for (MyMap<int, int>::iterator it = map.begin(); it != map.end(); ++it) {
+        visits[it.key()]++;
+        it.value() += count;
+    }
+    int viewed = 0;
+    for (int key : map.keysView()) {
+        isPassed = isPassed && (map.get(key) == key + count);
+        viewed++;
+    }
+    for (int key = 0; key < count; key++) {
+        isPassed = isPassed && (visits[key] == ((key % 5 == 0) ? 0 : 1));
+    }
+    return isPassed && (viewed == map.size());
+}
+
+/* Function: testMapSharedProbesCounting
+ * --------------------------------------
+ * Const lookups of one map from several threads count
+ * every lookup of every thread.
+ */
+static bool testMapSharedProbesCounting() {
+    const int count = 1000;
+    const int threadCount = 4;
+    const int rounds = 50;
+    MyMap<int, int> map;
+    vector<int> keys;
+    for (int key = 0; key < count; key++) {
+        map.put(key, key);
+        keys.push_back(key);
+    }
+    map.setProbesCounting(true);
+    map.resetStats();
+
+    const MyMap<int, int>& sharedMap = map;
+    vector<thread> threads;
+    vector<char> results(threadCount, true);
+    for (int t = 0; t < threadCount; t++) {
+        threads.push_back(thread([&, t]() {
+            vector<int> values(count);
+            for (int round = 0; round < rounds; round++) {
+                sharedMap.getBatch(keys.data(), count, values.data());
+                results[t] = results[t] && (values == keys);
+            }
+        }));
+    }
+    for (thread& worker : threads) {
+        worker.join();
+    }
+    MyMap<int, int>::Stats stats = map.stats();
+    bool isPassed = (stats.lookups == (long) threadCount * rounds * count)
+            && (stats.probes >= stats.lookups);
+    for (int t = 0; t < threadCount; t++) {
+        isPassed = isPassed && results[t];
+    }
+    return isPassed;
+}
+
+/* Function: check
+ * ---------------
+ * Writes result of one test and counts failure.
+ */
+static void check(const string& name, bool isPassed, int& failed, ostream& out) {
+    out << (isPassed ? "PASS " : "FAIL ") << name << endl;
+    if (!isPassed) {
+        failed++;
+    }
+}
+
+int runCollectionsTests(ostream& out) {
+    int failed = 0;
+    check("lru map recency order", testLruRecencyOrder(), failed, out);
+    check("lru map capacity", testLruCapacity(), failed, out);
+    check("lru map byte budget", testLruByteBudget(), failed, out);
+    check("lru map eviction callback and counters", testLruCallbackAndCounters(), failed, out);
+    check("map reserve and putAll", testMapReserveAndPutAll(), failed, out);
+    check("map batch lookups", testMapBatchLookups(), failed, out);
+    check("map iteration after rehash", testMapIterationAfterRehash(), failed, out);
+    check("map probes counting by threads", testMapSharedProbesCounting(), failed, out);
+    return failed;
+}
@@ -0,0 +1,23 @@
+/*******************************************************
+* File: CollectionsTests.h
+* --------------------------
+* v.1 2026/10/18
+*
+* Self tests of the collections from src folder, which
+* are run by "Huffman test" command after Huffman tests.
+*******************************************************/
+
+#ifndef CollectionsTests_Included
+#define CollectionsTests_Included
+
+#include <ostream>
+
+/* Function: runCollectionsTests
+ * Usage: int failed = runCollectionsTests(cout);
+ * ----------------------------------------------
+ * Runs every test, writes PASS or FAIL line of every one
+ * into out, and returns count of failed tests.
+ */
+int runCollectionsTests(std::ostream& out);
+
+#endif
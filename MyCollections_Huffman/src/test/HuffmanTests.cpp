@@ -0,0 +1,400 @@
+/**********************************************************
+* File: HuffmanTests.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* v.2 2026/10/18
+* - small texts don't grow more then stored container header
+*
+* v.3 2026/10/18
+* - round trips of every blocks coding, outputs of file, stream
+*   and buffer, broken containers and ranges at block bounds
+*
+* Implementation of the tests from HuffmanTests.h. Every
+* test works in its own folder of temporary directory.
+*
+**********************************************************/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "error.h"
+#include "filelib.h"
+#include "HuffmanBatch.h"
+#include "HuffmanBenchmark.h"
+#include "HuffmanBuffer.h"
+#include "HuffmanDecoding.h"
+#include "HuffmanEncoding.h"
+#include "HuffmanTests.h"
+#include "strlib.h"
+
+using namespace std;
+
+/* Function: makeTestDirectory
+ * ---------------------------
+ * Makes new empty folder in temporary directory.
+ */
+static string makeTestDirectory(const string& testName) {
+    long long stamp = chrono::steady_clock::now().time_since_epoch().count();
+    string dir = getTempDirectory() + "/huffman-" + testName + "-" + longToString(stamp);
+    createDirectory(dir);
+    return dir;
+}
+
+/* Function: removeTestDirectory
+ * -----------------------------
+ * Deletes folder with all its files and folders.
+ */
+static void removeTestDirectory(const string& dir) {
+    vector<string> names;
+    listDirectory(dir, names);
+    for (const string& name : names) {
+        string path = dir + "/" + name;
+        if (isDirectory(path)) {
+            removeTestDirectory(path);
+        } else {
+            deleteFile(path);
+        }
+    }
+    deleteFile(dir);
+}
+
+/* Function: writeTestFile
+ * -----------------------
+ * Makes folder of file and writes text into it.
+ */
+static void writeTestFile(const string& path, const string& text) {
+    createDirectory(getHead(path));
+    writeEntireFile(path, text);
+}
+
+/* Function: testBatchDuplicateNames
+ * ---------------------------------
+ * List has two files of one name from different folders.
+ * The second one has to fail, and output file has to keep
+ * text of the first one.
+ */
+static bool testBatchDuplicateNames() {
+    string dir = makeTestDirectory("batch-names");
+    writeTestFile(dir + "/a/log.txt", "text of the first log");
+    writeTestFile(dir + "/b/log.txt", "second log, which is longer then the first one");
+    writeEntireFile(dir + "/list", dir + "/a/log.txt\n" + dir + "/b/log.txt\n");
+
+    ostringstream report;
+    vector<BatchFile> files = listBatchFiles(dir + "/list");
+    int failed = runBatch(files, dir + "/out", true, 0, INTERLEAVED_BLOCKS, report);
+    int failedBack = runBatch(listBatchFiles(dir + "/out"), dir + "/back", false, 0,
+                              INTERLEAVED_BLOCKS, report);
+    vector<string> outputs;
+    listDirectory(dir + "/out", outputs);
+    bool isPassed = (files.size() == 2) && (failed == 1) && (failedBack == 0)
+            && (outputs.size() == 1) && (outputs[0] == "log.txt.huf")
+            && (readEntireFile(dir + "/back/log.txt") == "text of the first log");
+    removeTestDirectory(dir);
+    return isPassed;
+}
+
+/* Constant: TEST_CODINGS
+ * All codings of blocks, which every coding test runs.
+ */
+static const BlockCoding TEST_CODINGS[] = {
+    SINGLE_STREAM_BLOCKS, INTERLEAVED_BLOCKS, RANS_BLOCKS, LZ77_BLOCKS, CONTEXT_BLOCKS
+};
+static const int TEST_CODINGS_COUNT = 5;
+
+/* Function: compressText
+ * ----------------------
+ * Returns container of text made by compressBuffer.
+ */
+static vector<char> compressText(const string& text, BlockCoding coding, int threadCount = 1) {
+    vector<char> cypher;
+    VectorSink sink(cypher);
+    compressBuffer((const uint8_t*) text.data(), text.size(), sink, MAX_CODE_LENGTH,
+                   threadCount, coding);
+    return cypher;
+}
+
+/* Function: decompressText
+ * ------------------------
+ * Returns text of container made by decompressBuffer.
+ */
+static string decompressText(const vector<char>& cypher, int threadCount = 1) {
+    vector<char> text;
+    VectorSink sink(text);
+    decompressBuffer((const uint8_t*) cypher.data(), cypher.size(), sink, threadCount);
+    return string(text.begin(), text.end());
+}
+
+/* Constant: TEST_BLOCK_SIZE
+ * Small block size of multi-block tests, so that texts of
+ * few hundreds kilobytes have many blocks and groups.
+ */
+static const int TEST_BLOCK_SIZE = 4096;
+
+/* Function: makeTestText
+ * ----------------------
+ * Returns text of size bytes, whose parts give every kind
+ * of block: skewed bytes, run of one byte, random bytes
+ * and repeated sentences for LZ77 matches.
+ */
+static string makeTestText(size_t size, unsigned seed) {
+    vector<char> zipf = generateZipfText(size / 4, seed);
+    vector<char> uniform = generateUniformText(size / 4, seed + 1);
+    string text(zipf.begin(), zipf.end());
+    text.append(size / 8, 'z');
+    text.append(uniform.begin(), uniform.end());
+    while (text.size() < size) {
+        text += "The quick brown fox jumps over the lazy dog " + longToString(text.size()) + ". ";
+    }
+    text.resize(size);
+    return text;
+}
+
+/* Function: compressBlocksText
+ * ----------------------------
+ * Returns container of text with given block size, coded
+ * by threadCount threads.
+ */
+static string compressBlocksText(const string& text, BlockCoding coding, int threadCount,
+                                 int blockSize = TEST_BLOCK_SIZE) {
+    ostringstream out;
+    ThreadPool pool(threadCount);
+    compressBlocks((const unsigned char*) text.data(), text.size(), out, MAX_CODE_LENGTH,
+                   pool, blockSize, coding);
+    return out.str();
+}
+
+/* Function: decompressBlocksText
+ * ------------------------------
+ * Returns text of container decoded by threadCount threads.
+ */
+static string decompressBlocksText(const string& cypher, int threadCount) {
+    ostringstream out;
+    ThreadPool pool(threadCount);
+    decompressBlocks(cypher.data(), cypher.size(), out, pool);
+    return out.str();
+}
+
+/* Function: isRejected
+ * --------------------
+ * Returns true if decoding of cypher by buffer API reports
+ * error.
+ */
+static bool isRejected(const string& cypher) {
+    try {
+        decompressText(vector<char>(cypher.begin(), cypher.end()));
+    } catch (ErrorException&) {
+        return true;
+    }
+    return false;
+}
+
+/* Function: testSmallTextsDontGrow
+ * --------------------------------
+ * Texts smaller then container overhead - like fibonacci
+ * and singleChar of res folder - have to grow by stored
+ * container header at most, and to be decoded back.
+ */
+static bool testSmallTextsDontGrow() {
+    const string texts[] = {"", "a", "aa", "0 1 1 2 3 5 8 13 21 34 55 89 144 233",
+                            string("\xFF\x00\x7F\x80", 4)};
+    for (const string& text : texts) {
+        for (int i = 0; i < TEST_CODINGS_COUNT; i++) {
+            vector<char> cypher = compressText(text, TEST_CODINGS[i]);
+            if (cypher.size() > text.size() + CONTAINER_HEADER_SIZE) return false;
+            if (decompressText(cypher) != text) return false;
+        }
+    }
+    return true;
+}
+
+/* Function: testCodingRoundTrips
+ * -------------------------------
+ * Every coding decodes back empty text, one byte, text of
+ * single value and random text, by one and by many threads.
+ */
+static bool testCodingRoundTrips() {
+    vector<char> uniform = generateUniformText(50000, 7);
+    const string texts[] = {"", "x", string(50000, 'a'), string(uniform.begin(), uniform.end()),
+                            makeTestText(50000, 11)};
+    for (const string& text : texts) {
+        for (int i = 0; i < TEST_CODINGS_COUNT; i++) {
+            for (int threadCount : {1, 4}) {
+                vector<char> cypher = compressText(text, TEST_CODINGS[i], threadCount);
+                if (decompressText(cypher, threadCount) != text) return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Function: testMultiBlockRoundTrips
+ * ----------------------------------
+ * Text of many blocks and groups is the same container by
+ * one and by many threads, by text and by stream, and it's
+ * decoded back by all of them.
+ */
+static bool testMultiBlockRoundTrips() {
+    string text = makeTestText(300000, 23);
+    for (int i = 0; i < TEST_CODINGS_COUNT; i++) {
+        string cypher = compressBlocksText(text, TEST_CODINGS[i], 1);
+        if (compressBlocksText(text, TEST_CODINGS[i], 4) != cypher) return false;
+
+        istringstream in(text);
+        ostringstream streamCypher;
+        ThreadPool pool(1);
+        compressBlocksStream(in, streamCypher, MAX_CODE_LENGTH, pool, TEST_BLOCK_SIZE,
+                             TEST_CODINGS[i]);
+        if (streamCypher.str() != cypher) return false;
+
+        if (decompressBlocksText(cypher, 1) != text) return false;
+        if (decompressBlocksText(cypher, 4) != text) return false;
+        istringstream cypherIn(cypher);
+        ostringstream streamText;
+        ThreadPool streamPool(4);
+        decompressBlocksStream(cypherIn, streamText, streamPool);
+        if (streamText.str() != text) return false;
+    }
+    return true;
+}
+
+/* Function: testOutputsMatch
+ * --------------------------
+ * compress() into file, compressStream() and compressBuffer()
+ * write the same bytes, and every decoder gives text back.
+ * Messages of file functions are not shown.
+ */
+static bool testOutputsMatch() {
+    string dir = makeTestDirectory("outputs");
+    string text = makeTestText(200000, 31);
+    writeEntireFile(dir + "/text", text);
+    bool isPassed = true;
+    streambuf* console = cout.rdbuf();
+    ostringstream messages;
+    cout.rdbuf(messages.rdbuf());
+    try {
+        for (int i = 0; (i < TEST_CODINGS_COUNT) && isPassed; i++) {
+            compress(dir + "/text", dir + "/text.huf", MAX_CODE_LENGTH, 1, TEST_CODINGS[i]);
+            string fileCypher = readEntireFile(dir + "/text.huf");
+            istringstream in(text);
+            ostringstream streamCypher;
+            compressStream(in, streamCypher, MAX_CODE_LENGTH, 1, TEST_CODINGS[i]);
+            vector<char> bufferCypher = compressText(text, TEST_CODINGS[i]);
+
+            decompress(dir + "/text.huf", dir + "/text.out", 1);
+            istringstream cypherIn(fileCypher);
+            ostringstream streamText;
+            decompressStream(cypherIn, streamText, 1);
+            isPassed = (streamCypher.str() == fileCypher)
+                    && (string(bufferCypher.begin(), bufferCypher.end()) == fileCypher)
+                    && (readEntireFile(dir + "/text.out") == text)
+                    && (streamText.str() == text)
+                    && (decompressText(bufferCypher) == text);
+        }
+    } catch (ErrorException&) {
+        isPassed = false;
+    }
+    cout.rdbuf(console);
+    removeTestDirectory(dir);
+    return isPassed;
+}
+
+/* Function: testBrokenContainersRejected
+ * --------------------------------------
+ * Container, which is cut at any place, or has broken magic,
+ * block size, block header, index entry or footer, is
+ * rejected. Broken block data has no checksum, so it has
+ * to be rejected or decoded into text of the same size.
+ */
+static bool testBrokenContainersRejected() {
+    string text = makeTestText(40000, 43);
+    for (int i = 0; i < TEST_CODINGS_COUNT; i++) {
+        string cypher = compressBlocksText(text, TEST_CODINGS[i], 1);
+        for (size_t size = 0; size < cypher.size(); size += 1 + cypher.size() / 200) {
+            if (!isRejected(cypher.substr(0, size))) return false;
+        }
+        if (!isRejected(cypher.substr(0, cypher.size() - 1))) return false;
+
+        size_t indexOffset = cypher.size() - INDEX_FOOTER_SIZE - 10 * BLOCK_INDEX_ENTRY_SIZE;
+        const size_t brokenBytes[] = {
+            0,                                            // magic
+            HEADER_MAGIC_SIZE + 4,                        // block size
+            CONTAINER_HEADER_SIZE + 1,                    // text size of the first block
+            CONTAINER_HEADER_SIZE + 5,                    // data size of the first block
+            indexOffset + 16,                             // text size of index entry
+            cypher.size() - INDEX_FOOTER_SIZE,            // index offset
+            cypher.size() - 1                             // footer magic
+        };
+        for (size_t pos : brokenBytes) {
+            string broken = cypher;
+            broken[pos] ^= 0x40;
+            if (!isRejected(broken)) return false;
+        }
+
+        for (size_t pos = CONTAINER_HEADER_SIZE + BLOCK_HEADER_SIZE; pos < indexOffset; pos += 997) {
+            string broken = cypher;
+            broken[pos] ^= 0x5A;
+            try {
+                if (decompressBlocksText(broken, 1).size() != text.size()) return false;
+            } catch (ErrorException&) {
+                /* Rejected */
+            }
+        }
+    }
+    return true;
+}
+
+/* Function: testRangesAtBlockBounds
+ * ---------------------------------
+ * decompressRange() gives the same bytes as the text for
+ * ranges, which start, end or cross bounds of blocks, and
+ * for ranges out of the text.
+ */
+static bool testRangesAtBlockBounds() {
+    string dir = makeTestDirectory("ranges");
+    string text = makeTestText(10 * TEST_BLOCK_SIZE + 123, 53);
+    writeEntireFile(dir + "/text.huf", compressBlocksText(text, INTERLEAVED_BLOCKS, 1));
+    writeEntireFile(dir + "/small.huf", compressBlocksText("abc", INTERLEAVED_BLOCKS, 1));
+    const long long B = TEST_BLOCK_SIZE;
+    const long long ranges[][2] = {
+        {0, B}, {0, 1}, {B - 1, 2}, {B, B}, {B, 1}, {2 * B - 1, 1}, {100, 3 * B},
+        {9 * B, 2 * B}, {(long long) text.size() - 1, 10}, {(long long) text.size(), 5},
+        {0, 100 * B}
+    };
+    bool isPassed = true;
+    for (const long long* range : ranges) {
+        string expected = (range[0] < (long long) text.size()) ? text.substr(range[0], range[1])
+                                                              : string();
+        isPassed = isPassed && (decompressRange(dir + "/text.huf", range[0], range[1]) == expected);
+    }
+    isPassed = isPassed && (decompressRange(dir + "/small.huf", 1, 5) == "bc");
+    removeTestDirectory(dir);
+    return isPassed;
+}
+
+/* Function: check
+ * ---------------
+ * Writes result of one test and counts failure.
+ */
+static void check(const string& name, bool isPassed, int& failed, ostream& out) {
+    out << (isPassed ? "PASS " : "FAIL ") << name << endl;
+    if (!isPassed) {
+        failed++;
+    }
+}
+
+int runHuffmanTests(ostream& out) {
+    int failed = 0;
+    check("batch list with duplicate file names", testBatchDuplicateNames(), failed, out);
+    check("small texts don't grow", testSmallTextsDontGrow(), failed, out);
+    check("round trips of every coding", testCodingRoundTrips(), failed, out);
+    check("multi-block round trips by 1 and 4 threads", testMultiBlockRoundTrips(), failed, out);
+    check("file, stream and buffer outputs match", testOutputsMatch(), failed, out);
+    check("truncated and broken containers are rejected", testBrokenContainersRejected(),
+          failed, out);
+    check("ranges at block bounds", testRangesAtBlockBounds(), failed, out);
+    return failed;
+}
@@ -0,0 +1,23 @@
+/*******************************************************
+* File: HuffmanTests.h
+* --------------------------
+* v.1 2026/10/18
+*
+* Self tests of the Huffman program, which are run by
+* "Huffman test" command.
+*******************************************************/
+
+#ifndef HuffmanTests_Included
+#define HuffmanTests_Included
+
+#include <ostream>
+
+/* Function: runHuffmanTests
+ * Usage: int failed = runHuffmanTests(cout);
+ * ------------------------------------------
+ * Runs every test, writes PASS or FAIL line of every one
+ * into out, and returns count of failed tests.
+ */
+int runHuffmanTests(std::ostream& out);
+
+#endif
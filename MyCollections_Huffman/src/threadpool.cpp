@@ -0,0 +1,109 @@
+/**********************************************************
+* File: threadpool.cpp
+* --------------------------
+* v.1 2026/10/18
+*
+* Implementation of ThreadPool from threadpool.h.
+*
+**********************************************************/
+
+#include <algorithm>
+#include "threadpool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    task = NULL;
+    taskCount = 0;
+    nextTask = 0;
+    activeWorkers = 0;
+    batchNumber = 0;
+    stopping = false;
+    for (int i = 0; i < threadCount - 1; i++) {
+        workers.push_back(thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/* Method: run
+ * -----------
+ * Every worker takes part in every batch, so batch is
+ * over when all workers have left it.
+ */
+void ThreadPool::run(int taskCount, const function<void(int)>& task) {
+    if (taskCount <= 0) return;
+    {
+        lock_guard<mutex> lock(poolMutex);
+        this->task = &task;
+        this->taskCount = taskCount;
+        nextTask = 0;
+        activeWorkers = workers.size();
+        failure = nullptr;
+        batchNumber++;
+    }
+    startCondition.notify_all();
+    runTasks();
+
+    unique_lock<mutex> lock(poolMutex);
+    doneCondition.wait(lock, [this] { return activeWorkers == 0; });
+    this->task = NULL;
+    if (failure) {
+        rethrow_exception(failure);
+    }
+}
+
+/* Method: workerLoop
+ * ------------------
+ * Waits for the next batch, runs its tasks and
+ * reports that it's done.
+ */
+void ThreadPool::workerLoop() {
+    long lastBatch = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(poolMutex);
+            startCondition.wait(lock, [this, lastBatch] {
+                return stopping || (batchNumber != lastBatch);
+            });
+            if (stopping) return;
+            lastBatch = batchNumber;
+        }
+        runTasks();
+        lock_guard<mutex> lock(poolMutex);
+        if (--activeWorkers == 0) {
+            doneCondition.notify_all();
+        }
+    }
+}
+
+/* Method: runTasks
+ * ----------------
+ * Takes next task numbers until batch is over.
+ */
+void ThreadPool::runTasks() {
+    while (true) {
+        int taskNumber = nextTask++;
+        if (taskNumber >= taskCount) return;
+        try {
+            (*task)(taskNumber);
+        } catch (...) {
+            lock_guard<mutex> lock(poolMutex);
+            if (!failure) {
+                failure = current_exception();
+            }
+        }
+    }
+}
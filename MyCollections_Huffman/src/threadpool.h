@@ -0,0 +1,89 @@
+/*******************************************************
+* File: threadpool.h
+* --------------------------
+* v.1 2026/10/18
+*
+* Fixed set of worker threads, which run batches of
+* numbered tasks - for example blocks of a file.
+*******************************************************/
+
+#ifndef threadpool_Included
+#define threadpool_Included
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Class: ThreadPool
+ * -----------------
+ * Workers are started once and sleep between batches.
+ * Calling thread works on the batch too, so pool of
+ * N threads has N - 1 workers.
+ */
+class ThreadPool {
+public:
+    /*
+     * Constructor: ThreadPool
+     * Usage: ThreadPool pool;
+     *        ThreadPool pool(threadCount);
+     * ------------------------------------
+     * Thread count 0 means count of hardware threads.
+     */
+    ThreadPool(int threadCount = 0);
+
+    /*
+     * Destructor: ~ThreadPool
+     * -----------------------
+     * Stops and joins all workers.
+     */
+    ~ThreadPool();
+
+    /*
+     * Method: size
+     * ------------
+     * Returns count of threads, calling thread included.
+     */
+    int size() const {
+        return workers.size() + 1;
+    }
+
+    /*
+     * Method: run
+     * Usage: pool.run(blockCount, [&](int block) { ... });
+     * ----------------------------------------------------
+     * Calls task for every number from 0 to taskCount - 1,
+     * in any order and on any thread, and returns when all
+     * calls are done. The first exception thrown by task is
+     * thrown again from run.
+     */
+    void run(int taskCount, const std::function<void(int)>& task);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+
+    /* Current batch */
+    const std::function<void(int)>* task;
+    int taskCount;
+    std::atomic<int> nextTask;
+    int activeWorkers;
+    long batchNumber;
+    bool stopping;
+    std::exception_ptr failure;
+
+    void workerLoop();
+    void runTasks();
+
+    /* Threads can't be copied */
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+#endif